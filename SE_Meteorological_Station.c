@@ -1,11 +1,14 @@
 #include <stdio.h>
-#include <math.h>
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
 
 #include "pico/stdlib.h"
 #include "pico/time.h"
+#include "pico/rand.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
 #include "hardware/i2c.h"
 #include "hardware/gpio.h"
 #include "hardware/pio.h"
@@ -14,6 +17,7 @@
 #include "font.h"
 #include "bmp280.h"
 #include "aht20.h"
+#include "sensor_acq.h"
 #include "lwipopts.h"
 #include "globals.h"
 #include "wifi.h"
@@ -22,15 +26,28 @@
 #include "ws2812.h"
 #include "ws2812.pio.h"
 #include "buzzer.h"
+#include "alert_fx.h"
 #include "sensor_limits.h"
 #include "page_html.h"
+#include "page_html_gz.h"
+#include "flash_log.h"
+#include "fixed_point.h"
+#include "altitude.h"
+#include "app_tasks.h"
+#include "station_json.h"
+#include "task_stats.h"
+#include "spsc_ring.h"
+#include "seqlock.h"
+#include "timing_stats.h"
+#include "http_conn.h"
+#include "http_request.h"
 
 // Trecho para modo BOOTSEL com botão B
 #include "pico/bootrom.h"
 #define botaoB 6
-void gpio_irq_handler(uint gpio, uint32_t events) {
-    reset_usb_boot(0, 0);
-}
+FlashLog reading_log;                   // Log de leituras persistente na flash
+static volatile bool bootsel_requested = false; // Pedido do botão B, atendido pela tarefa de armazenamento
+void gpio_irq_handler(uint gpio, uint32_t events);
 
 // variaveis globais
 struct bmp280_calib_param params;       // Estrutura de calibração do BMP280
@@ -42,28 +59,119 @@ SensorLimits sensor_limits;
 void gpio_init_all();
 void update_display();
 void configureWiFi();
-double calculate_altitude(double pressure);
+void restore_reading_log();
+void update_led_bars(int32_t temperature, int32_t humidity, int32_t pressure,
+                     const LimitCheckResult *check, const SensorLimits *limits);
+AlertSeverity alert_severity(const LimitCheckResult *check);
 static err_t http_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
 static err_t http_sent(void *arg, struct tcp_pcb *tpcb, u16_t len);
 static err_t connection_callback(void *arg, struct tcp_pcb *newpcb, err_t err);
+static err_t http_poll(void *arg, struct tcp_pcb *tpcb);
 void start_http_server(void);
 bool extract_json_float(const char* json_str, const char* key, float* value);
 
-// Estrutura HTTP
-struct http_state {
-    char response[8000];
-    size_t len;
-    size_t sent;
-};
+// Estrutura HTTP: struct http_state (HttpConn) vem do pool estático em http_conn.h
+static void http_err(void *arg, err_t err);
+static err_t http_finish(struct tcp_pcb *tpcb, struct http_state *hs);
+static err_t http_process(struct tcp_pcb *tpcb, struct http_state *hs);
+static void http_build_response(struct http_state *hs, char *req, size_t req_len);
+static err_t http_reject_too_large(struct tcp_pcb *tpcb, struct http_state *hs);
+
+// Resposta com o pool cheio: constante na flash, enviada sem cópia e sem slot
+// Página principal: o corpo fica na flash (XIP) e o cabeçalho é montado uma vez na
+// inicialização (sem a linha Connection, que vem em uma parte à parte); tudo vai para o
+// lwIP por referência. A versão gzip (HTML_BODY_GZ)
+// é gerada no build e enviada quando o Accept-Encoding do cliente permite
+#define HTML_BODY_LEN (sizeof(HTML_BODY) - 1)
+static char page_header[224];
+static size_t page_header_len;
+static char page_header_gz[256];
+static size_t page_header_gz_len;
+
+// Cache HTTP: o navegador guarda as respostas e revalida a cada uso (no-cache) com
+// If-None-Match; sem mudança, a resposta é um 304 só com cabeçalhos.
+//  - Página: ETag forte do hash do conteúdo, calculado no build (page_html_gz.h)
+//  - JSON: ETag fraca com boot, leitura publicada e versão dos limites. É fraca porque o
+//    campo "timestamp" muda a cada resposta sem mudar o dado. O boot_id evita que uma
+//    ETag de antes de um reset (contadores zerados) valide dados novos
+#define HTTP_CACHE_CONTROL "Cache-Control: no-cache\r\n"
+static uint32_t boot_id;
+static uint32_t limits_version;         // Incrementada a cada publish_limits (thread tcpip)
+
+// Conexões HTTP/1.1 persistentes: o slot acompanha a conexão e atende várias requisições
+// (inclusive em pipelining); ociosa por HTTP_IDLE_TIMEOUT_S, é fechada. O fim dos
+// cabeçalhos diz ao cliente se a conexão continua
+static const char HTTP_KEEP_ALIVE_END[] = "Connection: keep-alive\r\n\r\n";
+static const char HTTP_CLOSE_END[] = "Connection: close\r\n\r\n";
+
+static const char HTTP_503_BUSY[] =
+    "HTTP/1.1 503 Service Unavailable\r\n"
+    "Content-Type: application/json\r\n"
+    "Content-Length: 24\r\n"
+    "Retry-After: 1\r\n"
+    "Connection: close\r\n\r\n"
+    "{\"error\": \"Server busy\"}";
+
+static const char HTTP_413_TOO_LARGE[] =
+    "HTTP/1.1 413 Content Too Large\r\n"
+    "Content-Type: application/json\r\n"
+    "Content-Length: 30\r\n"
+    "Connection: close\r\n\r\n"
+    "{\"error\": \"Request too large\"}";
+
+// Medições publicadas para o relatório (um escritor cada, ver timing_stats.h)
+// Tarefa de sensores: intervalo entre amostras e tempo de cada ciclo
+typedef struct {
+    TimingStats interval;
+    TimingStats bus;            // Ocupada com o barramento: coleta + disparo (sensor_acq)
+    TimingStats process;        // Compensação e publicação da leitura
+} SensorTiming;
+static SensorTiming sensor_timing;
+static SeqLock sensor_timing_lock;
+// Latência HTTP (thread tcpip): até a resposta montada e até o último byte confirmado
+typedef struct {
+    TimingStats service;
+    TimingStats complete;
+    TimingStats page;           // Até o último byte da página estática
+} HttpTiming;
+static HttpTiming http_timing;
+static SeqLock http_timing_lock;
+static HttpTiming http_timing_local;    // Cópia de trabalho da thread tcpip
+
+// Filas do pipeline (ver app_tasks.h)
+static QueueHandle_t reading_queue;     // sensor -> alerta
+static QueueHandle_t display_queue;     // alerta -> display (só a última)
+static QueueHandle_t led_queue;         // alerta -> LEDs/buzzer (só a última)
+static volatile uint32_t reading_drops = 0;     // Leituras descartadas por fila cheia
+
+// Núcleo 0 -> núcleo 1: leituras para o armazenamento, sem trava
+static SpscRing storage_ring;
+static SensorMessage storage_ring_items[STORAGE_RING_CAPACITY];
+static TaskHandle_t storage_handle;     // Acordada pela tarefa de sensores a cada leitura
+
+// Instantâneos publicados entre os núcleos (um escritor cada)
+static SeqLock snapshot_lock;           // Escrito pelo armazenamento, lido pelo HTTP
+static StationSnapshot station_snapshot;
+static SeqLock limits_lock;             // Escrito pelo HTTP, lido pelo alerta
+static SensorLimits published_limits;
+
+static void sensor_task(void *param);
+static void alert_task(void *param);
+static void display_task(void *param);
+static void led_task(void *param);
+static void storage_task(void *param);
+static void network_task(void *param);
+static void publish_snapshot(void);
+static void publish_limits(void);
+static void print_timing_report(void);
+static void http_timing_add(TimingStats *stats, uint64_t start_us);
+static void http_not_modified(struct http_state *hs, const char *etag, bool vary, const char *connection);
 
 int main() {
     stdio_init_all();
         
     gpio_init_all();
 
-    // Inicializa o wifi
-    configureWiFi();
-
     // Inicializa os limites dos sensores
     sensor_limits_init(&sensor_limits);
 
@@ -74,69 +182,174 @@ int main() {
     }
     sensor_limits_print(&sensor_limits);
 
-    // Inicializa o servidor HTTP
-    printf("Iniciando servidor HTTP...\n");
-    start_http_server();
+    // Inicialize o armazenamento de leituras
+    reading_store_init(&sensor_readings);
 
-    // Estrutura para armazenar os dados do sensor
-    AHT20_Data data;
-    int32_t raw_temp_bmp;
-    int32_t raw_pressure;
+    // Recupera o histórico gravado na flash antes do último reset
+    restore_reading_log();
 
-    char str_tmp[8];  // Buffer maior para armazenar a string
-    char str_press[8];  // Buffer maior para armazenar a string  
-    char str_umi[8];  // Buffer maior para armazenar a string 
+    // Estado inicial visível para o HTTP e para o alerta
+    seqlock_init(&snapshot_lock);
+    seqlock_init(&limits_lock);
+    seqlock_init(&sensor_timing_lock);
+    seqlock_init(&http_timing_lock);
+    timing_stats_reset(&sensor_timing.interval);
+    timing_stats_reset(&sensor_timing.bus);
+    timing_stats_reset(&sensor_timing.process);
+    timing_stats_reset(&http_timing_local.service);
+    timing_stats_reset(&http_timing_local.complete);
+    timing_stats_reset(&http_timing_local.page);
+    http_timing = http_timing_local;
+    boot_id = get_rand_32();
+    publish_snapshot();
+    publish_limits();
 
-    bool cor = true;
+    reading_queue = xQueueCreate(READING_QUEUE_LENGTH, sizeof(SensorMessage));
+    display_queue = xQueueCreate(1, sizeof(AlertMessage));
+    led_queue = xQueueCreate(1, sizeof(AlertMessage));
+    spsc_ring_init(&storage_ring, storage_ring_items, STORAGE_RING_CAPACITY, sizeof(SensorMessage));
 
-    // Inicialize o armazenamento de leituras
-    reading_store_init(&sensor_readings);
-        
-    while (1) {        
-        // Leitura do BMP280
-        bmp280_read_raw(I2C_PORT, &raw_temp_bmp, &raw_pressure);
-        int32_t temperature = bmp280_convert_temp(raw_temp_bmp, &params);
-        int32_t pressure = bmp280_convert_pressure(raw_pressure, raw_temp_bmp, &params);
-
-        printf("Pressao = %.3f kPa\n", pressure / 1000.0);
-        printf("Temperatura BMP: = %.2f C\n", temperature / 100.0);
-
-        // Leitura do AHT20
-        if (aht20_read(I2C_PORT, &data)){
-            printf("Temperatura AHT: %.2f C\n", data.temperature);
-            printf("Umidade: %.2f %%\n", data.humidity);
-        } else {
+    // Núcleo 0: medição e interface local (as IRQs de DMA e do timer de animação também
+    // ficam no núcleo 0, onde foram habilitadas por gpio_init_all)
+    xTaskCreateAffinitySet(sensor_task, "sensor", SENSOR_TASK_STACK, NULL, SENSOR_TASK_PRIORITY, ACQ_CORE_MASK, NULL);
+    xTaskCreateAffinitySet(alert_task, "alerta", ALERT_TASK_STACK, NULL, ALERT_TASK_PRIORITY, ACQ_CORE_MASK, NULL);
+    xTaskCreateAffinitySet(display_task, "display", DISPLAY_TASK_STACK, NULL, DISPLAY_TASK_PRIORITY, ACQ_CORE_MASK, NULL);
+    xTaskCreateAffinitySet(led_task, "leds", LED_TASK_STACK, NULL, LED_TASK_PRIORITY, ACQ_CORE_MASK, NULL);
+    // Núcleo 1: rede e armazenamento. O Wi-Fi é inicializado dentro de uma tarefa
+    // (o cyw43_arch cria as suas ao iniciar)
+    xTaskCreateAffinitySet(storage_task, "armazenamento", STORAGE_TASK_STACK, NULL, STORAGE_TASK_PRIORITY, NET_CORE_MASK, &storage_handle);
+    xTaskCreateAffinitySet(network_task, "rede", NETWORK_TASK_STACK, NULL, NETWORK_TASK_PRIORITY, NET_CORE_MASK, NULL);
+
+    vTaskStartScheduler();
+
+    // Só chega aqui se faltar memória para as tarefas do escalonador
+    printf("ERRO: Falha ao iniciar o FreeRTOS\n");
+    while (1) {
+        tight_loop_contents();
+    }
+    return 0;
+}
+
+// Aquisição: coleta, compensa e publica uma leitura por período. Nunca espera
+// pelas outras tarefas: as filas são escritas com timeout zero
+static void sensor_task(void *param) {
+    SensorAcq acq;              // Aquisição em duas fases (dispara em um ciclo, coleta no seguinte)
+    SensorMessage msg;
+    uint32_t sequence = 0;
+    SensorTiming timing;        // Cópia de trabalho de sensor_timing
+    uint64_t last_wake_us = 0;
+
+    // Dispara a primeira conversão; as seguintes são disparadas ao fim de cada ciclo
+    sensor_acq_init(&acq, I2C_PORT);
+    sensor_acq_trigger(&acq);
+    timing = sensor_timing;
+
+    // Prazos absolutos: cada ciclo começa SENSOR_PERIOD_MS depois do início do anterior,
+    // qualquer que seja a duração do ciclo, então a cadência não acumula atraso
+    TickType_t next_wake = xTaskGetTickCount();
+
+    while (1) {
+        // Intervalo real entre amostras (o desvio do nominal é o jitter)
+        uint64_t wake_us = time_us_64();
+        if (last_wake_us != 0) {
+            timing_stats_add(&timing.interval, (uint32_t)(wake_us - last_wake_us));
+        }
+        last_wake_us = wake_us;
+
+        // Coleta a conversão disparada no ciclo anterior. Em regime ela terminou durante
+        // a espera do período; se não, a tarefa dorme até o fim da conversão
+        while (!sensor_acq_poll(&acq)) {
+            int64_t wait_us = absolute_time_diff_us(get_absolute_time(), acq.ready_at);
+            vTaskDelay(wait_us > 0 ? pdMS_TO_TICKS((uint32_t)(wait_us + 999) / 1000) : 1);
+        }
+        uint64_t process_start = time_us_64();
+        int32_t temperature;    // centi-°C
+        uint32_t pressure;      // Pa
+        bmp280_compensate(acq.raw_temp, acq.raw_pressure, &params, &temperature, &pressure);
+
+        // Leitura do AHT20 (já convertida em ponto fixo pelo driver)
+        AHT20_Data data = acq.aht;
+        if (!acq.aht_ok) {
             printf("Erro na leitura do AHT20!\n");
             // Use valores padrão em caso de erro
-            data.temperature = 0.0f;
-            data.humidity = 00.0f;
-        }   
-        
-        // Calcule a média da temperatura entre os dois sensores
-        float avg_temp = (temperature / 100.0f + data.temperature) / 2.0f;
-        printf("Temperatura média: %.2f C\n", avg_temp);
+            data.temperature = 0;
+            data.humidity = 0;
+        }
+        msg.aht_ok = acq.aht_ok;
+        sensor_acq_consume(&acq);
 
-        // Verifica limites ANTES de armazenar
-        LimitCheckResult check_result = sensor_limits_check_all(&sensor_limits, 
-                                                       avg_temp, 
-                                                       data.humidity, 
-                                                       pressure / 100.0f);
-        
-        if (!check_result.all_ok) {
-            printf("⚠️  ALERTA: %s\n", check_result.alert_message);
-            
-            set_leds(255, 0, 0); // Vermelho
-            
-            cor = false; 
+        // Dispara a próxima conversão, que ocorre em paralelo ao resto do ciclo
+        sensor_acq_trigger(&acq);
+
+        msg.sequence = sequence++;
+        msg.temperature = (temperature + data.temperature) / 2;    // Média dos dois sensores
+        msg.humidity = data.humidity;
+        msg.pressure = (int32_t)pressure;
+        msg.process_us = (uint32_t)(time_us_64() - process_start);
+
+        if (xQueueSend(reading_queue, &msg, 0) != pdTRUE) reading_drops++;
+        if (spsc_ring_push(&storage_ring, &msg)) {
+            xTaskNotifyGive(storage_handle);
+        }
+
+        // Tempos do ciclo vão para o relatório periódico (print_timing_report)
+        timing_stats_add(&timing.bus, acq.cycle_us);
+        timing_stats_add(&timing.process, msg.process_us);
+        seqlock_write(&sensor_timing_lock, &sensor_timing, &timing, sizeof(timing));
+
+        xTaskDelayUntil(&next_wake, pdMS_TO_TICKS(SENSOR_PERIOD_MS));
+    }
+}
+
+// Avaliação: altitude e limites de cada leitura; repassa o resultado ao display e aos LEDs
+static void alert_task(void *param) {
+    SensorMessage reading;
+    AlertMessage out;
+
+    while (1) {
+        xQueueReceive(reading_queue, &reading, portMAX_DELAY);
+
+        // Últimos limites publicados pelo HTTP (a web pode alterá-los a qualquer momento)
+        seqlock_read(&limits_lock, &out.limits, &published_limits, sizeof(out.limits));
+
+        out.reading = reading;
+        // Altitude barométrica (cm) com o QNH configurado
+        out.altitude = altitude_from_pressure(reading.pressure, out.limits.sea_level_pressure);
+
+        out.check = sensor_limits_check_all(&out.limits,
+                                            reading.temperature,
+                                            reading.humidity,
+                                            reading.pressure,
+                                            out.altitude);
+        out.severity = alert_severity(&out.check);
+
+        if (!out.check.all_ok) {
+            printf("⚠️  ALERTA: %s\n", out.check.alert_message);
         } else {
             printf("✅ Todos os sensores OK\n");
-            set_leds(0, 50, 0); // Verde suave
-            cor = true; 
-        }                                               
-        
-        sprintf(str_tmp, "%.1fC", avg_temp);  // Temperatura já em °C
-        sprintf(str_umi, "%.1f%%", data.humidity);  // Umidade
-        sprintf(str_press, "%.1f", pressure / 1000.0); // Pressão em kPa
+        }
+
+        // Display e LEDs só mostram o estado mais recente
+        xQueueOverwrite(display_queue, &out);
+        xQueueOverwrite(led_queue, &out);
+    }
+}
+
+// Display: redesenha a tela e dispara o envio por DMA (não espera o fim do envio)
+static void display_task(void *param) {
+    AlertMessage msg;
+    char str_tmp[8];  // Buffer maior para armazenar a string
+    char str_press[8];  // Buffer maior para armazenar a string  
+    char str_umi[8];  // Buffer maior para armazenar a string 
+    char str_num[12];
+
+    while (1) {
+        xQueueReceive(display_queue, &msg, portMAX_DELAY);
+        bool cor = msg.check.all_ok;
+
+        snprintf(str_tmp, sizeof(str_tmp), "%sC", fp_format(str_num, sizeof(str_num), msg.reading.temperature, 2, 1));  // Temperatura em °C
+        snprintf(str_umi, sizeof(str_umi), "%s%%", fp_format(str_num, sizeof(str_num), msg.reading.humidity, 2, 1));    // Umidade
+        fp_format(str_press, sizeof(str_press), msg.reading.pressure, 3, 1);                                            // Pressão em kPa
 
         // Atualiza o conteúdo do display
         ssd1306_fill(&ssd, !cor);                           // Limpa o display
@@ -150,17 +363,150 @@ int main() {
         ssd1306_draw_string(&ssd, str_tmp, 14, 41);         // Temperatura
         ssd1306_draw_string(&ssd, str_press, 14, 52);       // Pressão
         ssd1306_draw_string(&ssd, str_umi, 73, 45);         // Umidade
-        ssd1306_send_data(&ssd);                            // Atualiza o display
-        
-        // Armazene a leitura na pilha (pressão em hPa para consistência)
-        reading_store_add(&sensor_readings, avg_temp, data.humidity, pressure / 100.0f);
+        if (!ssd1306_begin_flush(&ssd)) {                   // DMA envia em segundo plano só as janelas alteradas
+            printf("Display: envio anterior em andamento, quadro adiado\n");
+        }
+    }
+}
+
+// LEDs e buzzer: barras na matriz e efeito/padrão da severidade (o timer de animação envia)
+static void led_task(void *param) {
+    AlertMessage msg;
 
-        cyw43_arch_poll(); // Necessário para manter o Wi-Fi ativo
-        sleep_ms(1500); // Aumentado o delay para dar mais tempo ao sistema
+    while (1) {
+        xQueueReceive(led_queue, &msg, portMAX_DELAY);
+        update_led_bars(msg.reading.temperature, msg.reading.humidity, msg.reading.pressure,
+                        &msg.check, &msg.limits);
+        alert_fx_set_severity(msg.severity);
+    }
+}
+
+// O log em flash pertence à tarefa de armazenamento: a interrupção só a acorda, e ela grava
+// a página parcial e reinicia em BOOTSEL (flash_safe_execute não pode rodar em ISR)
+void gpio_irq_handler(uint gpio, uint32_t events) {
+    bootsel_requested = true;
+    if (storage_handle == NULL) {
+        reset_usb_boot(0, 0);           // Escalonador ainda não iniciado: nada a gravar
+        return;
+    }
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(storage_handle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// Armazenamento (núcleo 1): dono do histórico em RAM e do log em flash; também faz a
+// gravação adiada dos limites, que divide o núcleo com os callbacks HTTP que a agendam
+static void storage_task(void *param) {
+    SensorMessage msg;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (spsc_ring_pop(&storage_ring, &msg)) {
+            // Armazene a leitura na pilha, direto em ponto fixo
+            reading_store_add_fixed(&sensor_readings, msg.temperature, msg.humidity, msg.pressure);
+            publish_snapshot();
+
+            // Anexa a leitura ao log persistente (a flash só é gravada quando uma página enche)
+            const CodecSample *sample = reading_store_get_last_sample(&sensor_readings);
+            flash_log_append(&reading_log, sample->timestamp, sample->temperature, sample->humidity, sample->pressure);
+        }
+
+        // Grava os limites alterados pela web depois do período de silêncio
+        sensor_limits_service();
+
+        if (bootsel_requested) {
+            flash_log_flush(&reading_log);      // Grava a página parcial do log antes de reiniciar
+            reset_usb_boot(0, 0);
+        }
+    }
+}
+
+// Publica a última leitura do ReadingStore para os handlers HTTP
+static void publish_snapshot(void) {
+    static uint32_t sequence = 0;
+    StationSnapshot snap;
+    snap.sequence = sequence++;
+    snap.count = reading_store_count(&sensor_readings);
+    snap.valid = snap.count > 0;
+    if (snap.valid) {
+        snap.last_sample = *reading_store_get_last_sample(&sensor_readings);
+        snap.last = *reading_store_get_last(&sensor_readings);
+    } else {
+        memset(&snap.last_sample, 0, sizeof(snap.last_sample));
+        memset(&snap.last, 0, sizeof(snap.last));
+    }
+    seqlock_write(&snapshot_lock, &station_snapshot, &snap, sizeof(snap));
+}
+
+// Publica sensor_limits (alterados só pelos callbacks HTTP) para a tarefa de alerta
+static void publish_limits(void) {
+    limits_version++;
+    seqlock_write(&limits_lock, &published_limits, &sensor_limits, sizeof(sensor_limits));
+}
+
+// Intervalo entre amostras, tempos da aquisição e latência das requisições desde o boot
+static void print_timing_report(void) {
+    SensorTiming sensor;
+    HttpTiming http;
+    seqlock_read(&sensor_timing_lock, &sensor, &sensor_timing, sizeof(sensor));
+    const TimingStats *interval = &sensor.interval;
+    seqlock_read(&http_timing_lock, &http, &http_timing, sizeof(http));
+
+    printf("Amostragem: %lu intervalos, média %lu us, mín %lu us, máx %lu us, jitter %lu us\n",
+           (unsigned long)interval->count, (unsigned long)timing_stats_avg(interval),
+           (unsigned long)(interval->count ? interval->min_us : 0), (unsigned long)interval->max_us,
+           (unsigned long)timing_stats_jitter(interval, SENSOR_PERIOD_MS * 1000u));
+    printf("Aquisição: %lu ciclos, barramento em média %lu us (máx %lu us), "
+           "processamento em média %lu us (máx %lu us)\n",
+           (unsigned long)sensor.bus.count,
+           (unsigned long)timing_stats_avg(&sensor.bus), (unsigned long)sensor.bus.max_us,
+           (unsigned long)timing_stats_avg(&sensor.process), (unsigned long)sensor.process.max_us);
+    printf("HTTP: %lu requisições, resposta montada em média %lu us (máx %lu us), "
+           "concluída em média %lu us (máx %lu us)\n",
+           (unsigned long)http.service.count,
+           (unsigned long)timing_stats_avg(&http.service), (unsigned long)http.service.max_us,
+           (unsigned long)timing_stats_avg(&http.complete), (unsigned long)http.complete.max_us);
+    printf("Página: %lu envios, último byte confirmado em média %lu us (máx %lu us)\n",
+           (unsigned long)http.page.count,
+           (unsigned long)timing_stats_avg(&http.page), (unsigned long)http.page.max_us);
+
+    const HttpConnStats *pool = http_conn_stats();
+    printf("Pool HTTP: %lu/%d em uso, pico %lu, %lu conexões atendidas, %lu recusadas (503), "
+           "%lu ociosas fechadas\n",
+           (unsigned long)pool->in_use, HTTP_MAX_CONNECTIONS, (unsigned long)pool->high_water,
+           (unsigned long)pool->acquired, (unsigned long)pool->rejected, (unsigned long)pool->evicted);
+}
+
+// Inicializa a rede (núcleo 1) e depois imprime periodicamente o uso de CPU e pilha das tarefas
+static void network_task(void *param) {
+    // Inicializa o wifi
+    configureWiFi();
+
+    // A thread tcpip é criada pelo lwIP sem afinidade: fixa no núcleo da rede
+    TaskHandle_t tcpip = xTaskGetHandle(TCPIP_THREAD_NAME);
+    if (tcpip) {
+        vTaskCoreAffinitySet(tcpip, NET_CORE_MASK);
+    }
+
+    // Inicializa o servidor HTTP (API raw do lwIP: fora dos callbacks exige o lock do núcleo)
+    printf("Iniciando servidor HTTP...\n");
+    cyw43_arch_lwip_begin();
+    start_http_server();
+    cyw43_arch_lwip_end();
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(TASK_STATS_PERIOD_MS));
+        task_stats_print();
+        printf("Filas: %lu leituras e %lu gravações descartadas\n",
+               (unsigned long)reading_drops, (unsigned long)storage_ring.drops);
+        print_timing_report();
     }
-    
-    cyw43_arch_deinit(); // Desliga o Wi-Fi antes de sair
-    return 0;
+}
+
+// Estouro de pilha detectado pelo FreeRTOS (configCHECK_FOR_STACK_OVERFLOW)
+void vApplicationStackOverflowHook(TaskHandle_t task, char *name) {
+    panic("Estouro de pilha na tarefa %s", name);
 }
 
 void gpio_init_all() {
@@ -196,9 +542,13 @@ void gpio_init_all() {
     gpio_pull_up(I2C_SDA);
     gpio_pull_up(I2C_SCL);
 
-    // Inicializa o BMP280
+    // Inicializa o BMP280 em modo normal com o preset configurado no build
     bmp280_init(I2C_PORT);
     bmp280_get_calib_params(I2C_PORT, &params);
+    bmp280_config_t bmp_config = bmp280_preset_config(BMP280_DEFAULT_PRESET);
+    printf("BMP280: conversão %lu us, espera %lu us\n",
+           (unsigned long)bmp280_measurement_time_us(&bmp_config),
+           (unsigned long)bmp280_standby_time_us(bmp_config.standby));
 
     // Inicializa o AHT20
     aht20_reset(I2C_PORT);
@@ -211,15 +561,80 @@ void gpio_init_all() {
     uint offset = pio_add_program(pio, &ws2812_program);
     ws2812_program_init(pio, sm, offset, WS2812_PIN, 800000, false);
 
-    clear_buffer();
-    set_leds(0, 0, 0); // Limpa a matriz de LEDs
+    ws2812_init(pio, sm);   // Quadros enviados por DMA
+    ws2812_clear();
+
+    // Animações e bipes em segundo plano; arco-íris até a primeira leitura
+    alert_fx_init();
+    alert_fx_set_led_effect(LED_FX_RAINBOW);
     
     printf("GPIO inicializado com sucesso!\n");
 }
 
-// Função para calcular a altitude a partir da pressão atmosférica
-double calculate_altitude(double pressure) {
-    return 44330.0 * (1.0 - pow(pressure / SEA_LEVEL_PRESSURE, 0.1903));
+// Altura da barra (1 a WS2812_ROWS) da posição do valor dentro de [min, max]
+static int bar_level(int32_t value, int32_t min, int32_t max) {
+    if (value <= min) return 1;
+    if (value >= max) return WS2812_ROWS;
+    return 1 + (int)((int64_t)(value - min) * (WS2812_ROWS - 1) / (max - min));
+}
+
+static void draw_sensor_bar(int column, int32_t value, int32_t min, int32_t max, bool ok) {
+    if (ok) {
+        ws2812_draw_bar(column, bar_level(value, min, max), 0, 60, 0);    // Verde
+    } else {
+        ws2812_draw_bar(column, bar_level(value, min, max), 255, 0, 0);   // Vermelho
+    }
+}
+
+// Desenha as três barras; o timer de animação envia o quadro (não bloqueia)
+void update_led_bars(int32_t temperature, int32_t humidity, int32_t pressure,
+                     const LimitCheckResult *check, const SensorLimits *limits) {
+    ws2812_clear();
+    draw_sensor_bar(0, temperature, limits->min_temp, limits->max_temp, check->temperature_ok);
+    draw_sensor_bar(2, humidity, limits->min_humidity, limits->max_humidity, check->humidity_ok);
+    draw_sensor_bar(4, pressure, limits->min_pressure, limits->max_pressure, check->pressure_ok);
+    alert_fx_refresh();
+}
+
+// Severidade pelo número de grandezas fora dos limites
+AlertSeverity alert_severity(const LimitCheckResult *check) {
+    int failing = !check->temperature_ok + !check->humidity_ok + !check->pressure_ok + !check->altitude_ok;
+    if (failing >= 2) return ALERT_CRITICAL;
+    if (failing == 1) return ALERT_WARNING;
+    return ALERT_NONE;
+}
+
+// Recupera o log da flash e repõe as leituras no armazenamento em RAM
+void restore_reading_log() {
+    FlashLogIO io;
+    flash_log_pico_io(&io);
+    if (!flash_log_init(&reading_log, &io, FLASH_LOG_SIZE)) {
+        printf("ERRO: Região do log em flash inválida\n");
+        return;
+    }
+
+    FlashLogIter it;
+    FlashLogRecord rec;
+    CodecSample sample;
+    uint32_t restored = 0;
+    uint32_t last_timestamp = 0;
+    flash_log_iter_begin(&reading_log, &it);
+    while (flash_log_iter_next(&it, &rec)) {
+        sample.timestamp = rec.timestamp;
+        sample.temperature = rec.temperature;
+        sample.humidity = rec.humidity;
+        sample.pressure = rec.pressure;
+        reading_store_add_sample(&sensor_readings, &sample);
+        last_timestamp = rec.timestamp;
+        restored++;
+    }
+
+    // As novas leituras continuam a linha do tempo a partir do último registro recuperado
+    if (restored > 0) {
+        reading_store_set_time_base(&sensor_readings, last_timestamp + 1);
+    }
+    printf("Log em flash: %lu leituras recuperadas (setor %lu, página %lu)\n",
+           (unsigned long)restored, (unsigned long)reading_log.head_sector, (unsigned long)reading_log.head_page);
 }
 
 void configureWiFi() {
@@ -227,7 +642,7 @@ void configureWiFi() {
     printf("Inicializando Wi-Fi...\n");
     while(cyw43_arch_init()) {
         printf("ERRO: Falha ao inicializar o Wi-Fi! Tentando novamente em 5s...\n");
-        sleep_ms(5000);
+        vTaskDelay(pdMS_TO_TICKS(5000));
     }
 
     cyw43_arch_gpio_put(LED_PIN, 0);    // LED apagado inicialmente
@@ -237,13 +652,13 @@ void configureWiFi() {
     printf("Conectando à rede: %s\n", WIFI_SSID);
     while(cyw43_arch_wifi_connect_timeout_ms(WIFI_SSID, WIFI_PASS, CYW43_AUTH_WPA2_AES_PSK, 30000)) {
         printf("ERRO: Falha ao conectar ao Wi-Fi. Tentando novamente...\n");
-        sleep_ms(5000);
+        vTaskDelay(pdMS_TO_TICKS(5000));
     }
     wifi_connected = true;
     printf("Conectado com sucesso!\n");
     snprintf(ip_address_str, sizeof(ip_address_str), "%s", ip4addr_ntoa(netif_ip4_addr(netif_default)));
     printf("Endereço IP: %s\n", ip_address_str);
-    printf("Tamanho do HTML_BODY: %zu bytes\n", strlen(HTML_BODY));
+    printf("Tamanho do HTML_BODY: %u bytes (gzip: %u bytes)\n", (unsigned)HTML_BODY_LEN, (unsigned)HTML_BODY_GZ_LEN);
 }
 
 // Função auxiliar para extrair valores JSON de uma string POST
@@ -264,26 +679,17 @@ bool extract_json_float(const char* json_str, const char* key, float* value) {
 
 static err_t http_sent(void *arg, struct tcp_pcb *tpcb, u16_t len) {
     struct http_state *hs = (struct http_state *)arg;
-    printf("tcp_sent: %d bytes enviados\n", len);
-    
     if (!hs) return ERR_OK;
-    
-    hs->sent += len;
+    hs->idle_polls = 0;
+    hs->last_active_us = time_us_64();
     
     // Verifica se ainda há dados para enviar
-    if (hs->sent < hs->len) {
-        // Envia o restante dos dados
-        size_t remaining = hs->len - hs->sent;
-        size_t chunk_size = remaining > 1400 ? 1400 : remaining; // Valor seguro menor que TCP_MSS
-        
-        err_t err = tcp_write(tpcb, hs->response + hs->sent, chunk_size, TCP_WRITE_FLAG_COPY);
+    if (!http_conn_acked(hs, len)) {
+        // Enche de novo o buffer de envio com o restante
+        err_t err = http_conn_pump(hs, tpcb);
         if (err != ERR_OK) {
             printf("ERRO em http_sent: falha ao escrever dados TCP: %d\n", err);
-            free(hs);
-            tcp_arg(tpcb, NULL);
-            tcp_sent(tpcb, NULL);
-            tcp_close(tpcb);
-            return err;
+            return http_finish(tpcb, hs);
         }
         
         err = tcp_output(tpcb);
@@ -293,149 +699,289 @@ static err_t http_sent(void *arg, struct tcp_pcb *tpcb, u16_t len) {
         
         return ERR_OK;
     } else {
-        // Todos os dados foram enviados
-        free(hs);
-        tcp_arg(tpcb, NULL);
-        tcp_sent(tpcb, NULL);
-        tcp_close(tpcb);
-        return ERR_OK;
+        // Todos os dados foram enviados e confirmados
+        http_timing_add(hs->static_asset ? &http_timing_local.page : &http_timing_local.complete, hs->start_us);
+        if (!hs->keep_alive) {
+            return http_finish(tpcb, hs);
+        }
+        // Conexão persistente: atende a próxima requisição, se já chegou
+        http_conn_reset_response(hs);
+        return http_process(tpcb, hs);
     }
 }
 
 static err_t http_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err) {
+    struct http_state *hs = (struct http_state *)arg;
     if (!p) {
-        tcp_close(tpcb);
-        return ERR_OK;
+        // Cliente fechou: devolve o slot
+        return http_finish(tpcb, hs);
     }
 
-    char *req = (char *)p->payload;
-    printf("HTTP Request recebida: %.50s...\n", req);
-    
-    struct http_state *hs = malloc(sizeof(struct http_state));
     if (!hs) {
-        printf("ERRO: Falha ao alocar memória para http_state\n");
+        // Conexão aceita com o pool cheio
+        printf("AVISO: Pool HTTP cheio (%d conexões), respondendo 503\n", HTTP_MAX_CONNECTIONS);
+        tcp_recved(tpcb, p->tot_len);
+        pbuf_free(p);
+        tcp_write(tpcb, HTTP_503_BUSY, sizeof(HTTP_503_BUSY) - 1, 0);
+        tcp_output(tpcb);
+        http_conn_note_rejected();
+        return http_finish(tpcb, NULL);
+    }
+
+    if (p->tot_len > HTTP_REQUEST_SIZE - hs->request_len) {
+        // Buffer cheio com uma resposta saindo: o lwIP guarda o pbuf e entrega de novo depois
+        if (http_conn_busy(hs)) return ERR_MEM;
+        tcp_recved(tpcb, p->tot_len);
         pbuf_free(p);
-        tcp_close(tpcb);
-        return ERR_MEM;
+        return http_reject_too_large(tpcb, hs);
+    }
+
+    pbuf_copy_partial(p, hs->request + hs->request_len, p->tot_len, 0);
+    hs->request_len += p->tot_len;
+    tcp_recved(tpcb, p->tot_len);
+    pbuf_free(p);
+    hs->idle_polls = 0;
+    hs->last_active_us = time_us_64();
+
+    return http_process(tpcb, hs);
+}
+
+// Atende a próxima requisição completa do buffer. Com pipelining, as respostas saem na
+// ordem das requisições, uma por vez: a seguinte é atendida quando a anterior é confirmada
+static err_t http_process(struct tcp_pcb *tpcb, struct http_state *hs) {
+    if (http_conn_busy(hs)) return ERR_OK;
+
+    size_t req_len = http_request_length(hs->request, hs->request_len);
+    if (req_len > HTTP_REQUEST_SIZE || (req_len == 0 && hs->request_len == HTTP_REQUEST_SIZE)) {
+        return http_reject_too_large(tpcb, hs);
     }
-    hs->sent = 0;
+    if (req_len == 0 || req_len > hs->request_len) {
+        return ERR_OK;          // Requisição ainda chegando
+    }
+
+    hs->start_us = time_us_64();
+    char *req = hs->request;
+    char next = req[req_len];
+    req[req_len] = '\0';       // Rotas usam strstr: limita a busca a esta requisição
+    printf("HTTP Request recebida: %.50s...\n", req);
+
+    hs->keep_alive = http_keep_alive(req, req_len);
+    http_build_response(hs, req, req_len);
+
+    // Consome a requisição; o que vier depois (pipelining) fica para a próxima resposta
+    req[req_len] = next;
+    hs->request_len -= req_len;
+    memmove(req, req + req_len, hs->request_len);
+    
+    // Enviar o que couber no buffer de envio; o restante sai a cada confirmação
+    err_t write_err = http_conn_pump(hs, tpcb);
+    if (write_err != ERR_OK) {
+        printf("ERRO: Falha ao escrever resposta TCP: %d\n", write_err);
+        return http_finish(tpcb, hs);
+    }
+    
+    err_t output_err = tcp_output(tpcb);
+    if (output_err != ERR_OK) {
+        printf("ERRO: Falha ao enviar resposta TCP: %d\n", output_err);
+    }
+    http_timing_add(&http_timing_local.service, hs->start_us);
+    
+    return ERR_OK;
+}
+
+// Monta a resposta de uma requisição (terminada em '\0') nas partes do slot
+static void http_build_response(struct http_state *hs, char *req, size_t req_len) {
+    const char *connection = hs->keep_alive ? HTTP_KEEP_ALIVE_END : HTTP_CLOSE_END;
+
+    // Última leitura publicada pelo armazenamento (o ReadingStore é do outro lado).
+    // sensor_limits só é alterado aqui, na thread tcpip, então é lido direto
+    StationSnapshot snap;
+    seqlock_read(&snapshot_lock, &snap, &station_snapshot, sizeof(snap));
+    const SensorReading *last_reading = snap.valid ? &snap.last : NULL;
 
-    const SensorReading *last_reading = reading_store_get_last(&sensor_readings);
+    // Rotas JSON que dependem só da leitura e dos limites: revalidáveis por ETag
+    bool cacheable = strstr(req, "GET /temperature") || strstr(req, "GET /humidity") ||
+                     strstr(req, "GET /atm_pressure") || strstr(req, "GET /altitude") ||
+                     strstr(req, "GET /sensor_status") || strstr(req, "GET /limits") ||
+                     strstr(req, "GET /api/snapshot");
+    char data_etag[40];
+    snprintf(data_etag, sizeof(data_etag), "W/\"%08lx-%lu-%lu\"", (unsigned long)boot_id,
+             (unsigned long)snap.sequence, (unsigned long)limits_version);
     
     // Verificação de segurança para dados dos sensores
-    if (!last_reading && (strstr(req, "/temperature") || strstr(req, "/humidity") || strstr(req, "/atm_pressure") || strstr(req, "/sensor_status"))) {
+    if (!last_reading && (strstr(req, "/temperature") || strstr(req, "/humidity") || strstr(req, "/atm_pressure") || strstr(req, "/altitude") || strstr(req, "/sensor_status"))) {
         printf("AVISO: Nenhuma leitura de sensor disponível\n");
         char json_payload[] = "{\"error\": \"No sensor data available\"}";
         hs->len = snprintf(hs->response, sizeof(hs->response),
             "HTTP/1.1 503 Service Unavailable\r\n"
             "Content-Type: application/json\r\n"
             "Content-Length: %d\r\n"
-            "Connection: close\r\n\r\n%s",
-            (int)strlen(json_payload), json_payload);
+            "%s%s",
+            (int)strlen(json_payload), connection, json_payload);
+    }
+    // Nada mudou desde a resposta que o cliente tem em cache
+    else if (cacheable && http_etag_matches(req, req_len, data_etag)) {
+        http_not_modified(hs, data_etag, false, connection);
     }
     // === ROTAS DOS SENSORES ===
     else if (strstr(req, "GET /temperature")) {
         printf("Servindo rota /temperature: %.2f°C\n", last_reading->temperature);
         char json_payload[256];
-        int json_len = snprintf(json_payload, sizeof(json_payload), 
-            "{\"value\": %.1f, \"unit\": \"°C\", \"timestamp\": %lu}", 
-            last_reading->temperature, 
-            (unsigned long)time(NULL));
+        int json_len = station_json_value(json_payload, sizeof(json_payload), last_reading->temperature, "°C",
+                                          (unsigned long)time(NULL));
         
         hs->len = snprintf(hs->response, sizeof(hs->response),
             "HTTP/1.1 200 OK\r\n"
             "Content-Type: application/json\r\n"
             "Content-Length: %d\r\n"
-            "Connection: close\r\n\r\n%s",
-            json_len, json_payload);
+            "ETag: %s\r\n"
+            HTTP_CACHE_CONTROL
+            "%s%s",
+            json_len, data_etag, connection, json_payload);
     }
     else if(strstr(req, "GET /humidity")) {
         printf("Servindo rota /humidity: %.2f%%\n", last_reading->humidity);
         char json_payload[256];
-        int json_len = snprintf(json_payload, sizeof(json_payload), 
-            "{\"value\": %.1f, \"unit\": \"%%\", \"timestamp\": %lu}", 
-            last_reading->humidity,
-            (unsigned long)time(NULL));
+        int json_len = station_json_value(json_payload, sizeof(json_payload), last_reading->humidity, "%",
+                                          (unsigned long)time(NULL));
         
         hs->len = snprintf(hs->response, sizeof(hs->response),
             "HTTP/1.1 200 OK\r\n"
             "Content-Type: application/json\r\n"
             "Content-Length: %d\r\n"
-            "Connection: close\r\n\r\n%s",
-            json_len, json_payload);
+            "ETag: %s\r\n"
+            HTTP_CACHE_CONTROL
+            "%s%s",
+            json_len, data_etag, connection, json_payload);
     }
     else if(strstr(req, "GET /atm_pressure")) {
         printf("Servindo rota /atm_pressure: %.2f hPa\n", last_reading->pressure);
         char json_payload[256];
+        int json_len = station_json_value(json_payload, sizeof(json_payload), last_reading->pressure, "hPa",
+                                          (unsigned long)time(NULL));
+        
+        hs->len = snprintf(hs->response, sizeof(hs->response),
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: application/json\r\n"
+            "Content-Length: %d\r\n"
+            "ETag: %s\r\n"
+            HTTP_CACHE_CONTROL
+            "%s%s",
+            json_len, data_etag, connection, json_payload);
+    }
+    else if(strstr(req, "GET /altitude")) {
+        const CodecSample *last_sample = &snap.last_sample;
+        int32_t altitude = altitude_from_pressure((int32_t)last_sample->pressure * 10 + READING_PRESSURE_BASE_PA,
+                                                  sensor_limits.sea_level_pressure);
+        printf("Servindo rota /altitude: %.2f m\n", fp_to_float(altitude, 100));
+        char json_payload[256];
         int json_len = snprintf(json_payload, sizeof(json_payload), 
-            "{\"value\": %.1f, \"unit\": \"hPa\", \"timestamp\": %lu}", 
-            last_reading->pressure,
+            "{\"value\": %.1f, \"unit\": \"m\", \"qnh\": %.2f, \"timestamp\": %lu}", 
+            fp_to_float(altitude, 100),
+            fp_to_float(sensor_limits.sea_level_pressure, 100),
             (unsigned long)time(NULL));
         
         hs->len = snprintf(hs->response, sizeof(hs->response),
             "HTTP/1.1 200 OK\r\n"
             "Content-Type: application/json\r\n"
             "Content-Length: %d\r\n"
-            "Connection: close\r\n\r\n%s",
-            json_len, json_payload);
+            "ETag: %s\r\n"
+            HTTP_CACHE_CONTROL
+            "%s%s",
+            json_len, data_etag, connection, json_payload);
+    }
+    // === ROTA COM O ESTADO COMPLETO (uma requisição por atualização do painel) ===
+    // Leitura, limites, estado de cada sensor e do alerta em um JSON compacto. seq muda a
+    // cada leitura publicada; sem leitura ainda, reading e status são null
+    else if(strstr(req, "GET /api/snapshot")) {
+        printf("Servindo rota /api/snapshot\n");
+        int32_t altitude = 0;
+        LimitCheckResult check_result;
+        AlertSeverity severity = ALERT_NONE;
+
+        if (last_reading) {
+            const CodecSample *last_sample = &snap.last_sample;
+            int32_t last_pressure = (int32_t)last_sample->pressure * 10 + READING_PRESSURE_BASE_PA;
+            altitude = altitude_from_pressure(last_pressure, sensor_limits.sea_level_pressure);
+            check_result = sensor_limits_check_all(&sensor_limits,
+                                                  last_sample->temperature,
+                                                  last_sample->humidity,
+                                                  last_pressure,
+                                                  altitude);
+            severity = alert_severity(&check_result);
+        }
+
+        char json_payload[896];
+        int json_len = station_json_snapshot(json_payload, sizeof(json_payload), snap.sequence, last_reading,
+                                             altitude, &sensor_limits, last_reading ? &check_result : NULL,
+                                             severity);
+
+        hs->len = snprintf(hs->response, sizeof(hs->response),
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: application/json\r\n"
+            "Content-Length: %d\r\n"
+            "ETag: %s\r\n"
+            HTTP_CACHE_CONTROL
+            "%s%s",
+            json_len, data_etag, connection, json_payload);
     }
     // === ROTA PARA STATUS GERAL DOS SENSORES ===
     else if(strstr(req, "GET /sensor_status")) {
         printf("Servindo rota /sensor_status\n");
+        const CodecSample *last_sample = &snap.last_sample;
+        int32_t last_pressure = (int32_t)last_sample->pressure * 10 + READING_PRESSURE_BASE_PA;
+        int32_t altitude = altitude_from_pressure(last_pressure, sensor_limits.sea_level_pressure);
         LimitCheckResult check_result = sensor_limits_check_all(&sensor_limits, 
-                                                               last_reading->temperature, 
-                                                               last_reading->humidity, 
-                                                               last_reading->pressure);
+                                                               last_sample->temperature, 
+                                                               last_sample->humidity, 
+                                                               last_pressure,
+                                                               altitude);
         
-        char json_payload[512];
-        int json_len = snprintf(json_payload, sizeof(json_payload), 
-            "{"
-            "\"temperature\": {\"value\": %.1f, \"ok\": %s},"
-            "\"humidity\": {\"value\": %.1f, \"ok\": %s},"
-            "\"pressure\": {\"value\": %.1f, \"ok\": %s},"
-            "\"all_ok\": %s,"
-            "\"alert_message\": \"%s\","
-            "\"timestamp\": %lu"
-            "}", 
-            last_reading->temperature, check_result.temperature_ok ? "true" : "false",
-            last_reading->humidity, check_result.humidity_ok ? "true" : "false",
-            last_reading->pressure, check_result.pressure_ok ? "true" : "false",
-            check_result.all_ok ? "true" : "false",
-            check_result.alert_message,
-            (unsigned long)time(NULL));
+        char json_payload[768];
+        int json_len = station_json_status(json_payload, sizeof(json_payload), last_reading, altitude,
+                                           &check_result, (unsigned long)time(NULL));
         
         hs->len = snprintf(hs->response, sizeof(hs->response),
             "HTTP/1.1 200 OK\r\n"
             "Content-Type: application/json\r\n"
             "Content-Length: %d\r\n"
-            "Connection: close\r\n\r\n%s",
-            json_len, json_payload);
+            "ETag: %s\r\n"
+            HTTP_CACHE_CONTROL
+            "%s%s",
+            json_len, data_etag, connection, json_payload);
+    }
+    // === ROTA PARA OCUPAÇÃO DO POOL DE CONEXÕES ===
+    else if(strstr(req, "GET /http_stats")) {
+        const HttpConnStats *pool = http_conn_stats();
+        char json_payload[192];
+        int json_len = snprintf(json_payload, sizeof(json_payload),
+            "{\"pool_size\": %d, \"in_use\": %lu, \"high_water\": %lu, \"served\": %lu, "
+            "\"requests\": %lu, \"rejected\": %lu, \"evicted\": %lu}",
+            HTTP_MAX_CONNECTIONS, (unsigned long)pool->in_use, (unsigned long)pool->high_water,
+            (unsigned long)pool->acquired, (unsigned long)http_timing_local.service.count,
+            (unsigned long)pool->rejected, (unsigned long)pool->evicted);
+
+        hs->len = snprintf(hs->response, sizeof(hs->response),
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: application/json\r\n"
+            "Content-Length: %d\r\n"
+            "%s%s",
+            json_len, connection, json_payload);
     }
     // === ROTA GET PARA OBTER LIMITES ===
     else if(strstr(req, "GET /limits")) {
         printf("Servindo rota /limits\n");
         char json_payload[512];
-        int json_len = snprintf(json_payload, sizeof(json_payload),
-            "{"
-            "\"min_temp\": %.1f,"
-            "\"max_temp\": %.1f,"
-            "\"min_hum\": %.1f,"
-            "\"max_hum\": %.1f,"
-            "\"min_press\": %.1f,"
-            "\"max_press\": %.1f,"
-            "\"alert_enabled\": %s"
-            "}",
-            sensor_limits.min_temp, sensor_limits.max_temp,
-            sensor_limits.min_humidity, sensor_limits.max_humidity,
-            sensor_limits.min_pressure, sensor_limits.max_pressure,
-            sensor_limits.alert_enabled ? "true" : "false");
+        int json_len = station_json_limits(json_payload, sizeof(json_payload), &sensor_limits);
         
         hs->len = snprintf(hs->response, sizeof(hs->response),
             "HTTP/1.1 200 OK\r\n"
             "Content-Type: application/json\r\n"
             "Content-Length: %d\r\n"
-            "Connection: close\r\n\r\n%s",
-            json_len, json_payload);
+            "ETag: %s\r\n"
+            HTTP_CACHE_CONTROL
+            "%s%s",
+            json_len, data_etag, connection, json_payload);
     }
     // === ROTA POST PARA DEFINIR LIMITES ===
     else if(strstr(req, "POST /limits")) {
@@ -461,22 +1007,32 @@ static err_t http_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t er
                 printf("Atualizando limites: T[%.1f-%.1f], H[%.1f-%.1f], P[%.1f-%.1f]\n",
                        min_temp, max_temp, min_hum, max_hum, min_press, max_press);
                 
-                // Atualiza os limites
+                // Atualiza os limites (JSON em °C, % e hPa -> ponto fixo)
                 sensor_limits_set_all(&sensor_limits, 
-                                    min_temp, max_temp,
-                                    min_hum, max_hum, 
-                                    min_press, max_press);
+                                    fp_from_float(min_temp, 100), fp_from_float(max_temp, 100),
+                                    fp_from_float(min_hum, 100), fp_from_float(max_hum, 100), 
+                                    fp_from_float(min_press, 100), fp_from_float(max_press, 100));
+
+                // Altitude (m) e QNH (hPa) são opcionais no JSON
+                float min_alt, max_alt, qnh;
+                if (extract_json_float(body, "min_alt", &min_alt) && extract_json_float(body, "max_alt", &max_alt)) {
+                    sensor_limits_set_altitude(&sensor_limits, fp_from_float(min_alt, 100), fp_from_float(max_alt, 100));
+                }
+                if (extract_json_float(body, "qnh", &qnh)) {
+                    sensor_limits_set_qnh(&sensor_limits, fp_from_float(qnh, 100));
+                }
                 
                 // Salva os limites
                 sensor_limits_save(&sensor_limits);
+                publish_limits();
                 
                 char json_payload[] = "{\"status\": \"success\", \"message\": \"Limites atualizados\"}";
                 hs->len = snprintf(hs->response, sizeof(hs->response),
                     "HTTP/1.1 200 OK\r\n"
                     "Content-Type: application/json\r\n"
                     "Content-Length: %d\r\n"
-                    "Connection: close\r\n\r\n%s",
-                    (int)strlen(json_payload), json_payload);
+                    "%s%s",
+                    (int)strlen(json_payload), connection, json_payload);
             } else {
                 printf("ERRO: Falha ao extrair dados JSON\n");
                 char json_payload[] = "{\"status\": \"error\", \"message\": \"Dados inválidos\"}";
@@ -484,8 +1040,8 @@ static err_t http_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t er
                     "HTTP/1.1 400 Bad Request\r\n"
                     "Content-Type: application/json\r\n"
                     "Content-Length: %d\r\n"
-                    "Connection: close\r\n\r\n%s",
-                    (int)strlen(json_payload), json_payload);
+                    "%s%s",
+                    (int)strlen(json_payload), connection, json_payload);
             }
         } else {
             printf("ERRO: Corpo da requisição não encontrado\n");
@@ -494,8 +1050,8 @@ static err_t http_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t er
                 "HTTP/1.1 400 Bad Request\r\n"
                 "Content-Type: application/json\r\n"
                 "Content-Length: %d\r\n"
-                "Connection: close\r\n\r\n%s",
-                (int)strlen(json_payload), json_payload);
+                "%s%s",
+                (int)strlen(json_payload), connection, json_payload);
         }
     }
     // === ROTA PARA ALTERNAR ALERTAS ===
@@ -503,6 +1059,7 @@ static err_t http_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t er
         printf("Alternando alertas\n");
         sensor_limits.alert_enabled = !sensor_limits.alert_enabled;
         sensor_limits_save(&sensor_limits);
+        publish_limits();
         
         char json_payload[128];
         int json_len = snprintf(json_payload, sizeof(json_payload),
@@ -513,70 +1070,160 @@ static err_t http_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t er
             "HTTP/1.1 200 OK\r\n"
             "Content-Type: application/json\r\n"
             "Content-Length: %d\r\n"
-            "Connection: close\r\n\r\n%s",
-            json_len, json_payload);
+            "%s%s",
+            json_len, connection, json_payload);
     }
     // === ROTA PARA RESETAR LIMITES AOS PADRÕES ===
     else if(strstr(req, "POST /reset_limits")) {
         printf("Resetando limites aos padrões\n");
         sensor_limits_init(&sensor_limits);
         sensor_limits_save(&sensor_limits);
+        publish_limits();
         
         char json_payload[] = "{\"status\": \"success\", \"message\": \"Limites resetados aos padrões\"}";
         hs->len = snprintf(hs->response, sizeof(hs->response),
             "HTTP/1.1 200 OK\r\n"
             "Content-Type: application/json\r\n"
             "Content-Length: %d\r\n"
-            "Connection: close\r\n\r\n%s",
-            (int)strlen(json_payload), json_payload);
+            "%s%s",
+            (int)strlen(json_payload), connection, json_payload);
     }
     else {
-        printf("Servindo página principal HTML (%zu bytes)\n", strlen(HTML_BODY));
-        hs->len = snprintf(hs->response, sizeof(hs->response),
-                           "HTTP/1.1 200 OK\r\n"
-                           "Content-Type: text/html; charset=UTF-8\r\n"
-                           "Content-Length: %d\r\n"
-                           "Connection: close\r\n\r\n%s",
-                           (int)strlen(HTML_BODY), HTML_BODY);
+        // Página estática: cabeçalho pré-montado e corpo direto da flash, sem cópia
+        bool gzip = http_accepts_gzip(req, req_len);
+        if (http_etag_matches(req, req_len, gzip ? HTML_BODY_GZ_ETAG : HTML_BODY_ETAG)) {
+            printf("Página principal não modificada (304)\n");
+            http_not_modified(hs, gzip ? HTML_BODY_GZ_ETAG : HTML_BODY_ETAG, true, connection);
+        } else if (gzip) {
+            printf("Servindo página principal HTML (gzip, %u bytes)\n", (unsigned)HTML_BODY_GZ_LEN);
+            http_conn_add_part(hs, page_header_gz, page_header_gz_len, false);
+            http_conn_add_part(hs, connection, strlen(connection), false);
+            http_conn_add_part(hs, (const char *)HTML_BODY_GZ, HTML_BODY_GZ_LEN, false);
+        } else {
+            printf("Servindo página principal HTML (%u bytes)\n", (unsigned)HTML_BODY_LEN);
+            http_conn_add_part(hs, page_header, page_header_len, false);
+            http_conn_add_part(hs, connection, strlen(connection), false);
+            http_conn_add_part(hs, HTML_BODY, HTML_BODY_LEN, false);
+        }
+        hs->static_asset = true;
     }
 
-    pbuf_free(p);
-    tcp_arg(tpcb, hs);
-    tcp_sent(tpcb, http_sent);
-    
-    // Enviar a primeira parte da resposta
-    size_t chunk_size = hs->len > 1400 ? 1400 : hs->len; // Valor seguro menor que TCP_MSS
-    
-    err_t write_err = tcp_write(tpcb, hs->response, chunk_size, TCP_WRITE_FLAG_COPY);
-    if (write_err != ERR_OK) {
-        printf("ERRO: Falha ao escrever resposta TCP: %d\n", write_err);
-        free(hs);
-        tcp_arg(tpcb, NULL);
-        tcp_sent(tpcb, NULL);
-        tcp_close(tpcb);
-        return write_err;
+    // Respostas montadas no slot viram uma única parte, copiada pelo lwIP
+    if (hs->part_count == 0) {
+        http_conn_add_part(hs, hs->response, hs->len, true);
     }
-    
-    err_t output_err = tcp_output(tpcb);
-    if (output_err != ERR_OK) {
-        printf("ERRO: Falha ao enviar resposta TCP: %d\n", output_err);
+}
+
+// 304 Not Modified: só cabeçalhos, montados no slot
+static void http_not_modified(struct http_state *hs, const char *etag, bool vary, const char *connection) {
+    hs->len = snprintf(hs->response, sizeof(hs->response),
+        "HTTP/1.1 304 Not Modified\r\n"
+        "ETag: %s\r\n"
+        HTTP_CACHE_CONTROL
+        "%s%s",
+        etag, vary ? "Vary: Accept-Encoding\r\n" : "", connection);
+}
+
+// Requisição maior que o buffer do slot: responde 413 e fecha
+static err_t http_reject_too_large(struct tcp_pcb *tpcb, struct http_state *hs) {
+    printf("AVISO: Requisição HTTP maior que %d bytes, respondendo 413\n", HTTP_REQUEST_SIZE);
+    tcp_write(tpcb, HTTP_413_TOO_LARGE, sizeof(HTTP_413_TOO_LARGE) - 1, 0);
+    tcp_output(tpcb);
+    return http_finish(tpcb, hs);
+}
+
+// Encerra a conexão e devolve o slot ao pool. Retorna ERR_ABRT se o PCB teve de ser
+// abortado, valor que o callback do lwIP deve repassar
+static err_t http_finish(struct tcp_pcb *tpcb, struct http_state *hs) {
+    tcp_arg(tpcb, NULL);
+    tcp_sent(tpcb, NULL);
+    tcp_recv(tpcb, NULL);
+    tcp_err(tpcb, NULL);
+    tcp_poll(tpcb, NULL, 0);
+    http_conn_release(hs);
+    if (tcp_close(tpcb) != ERR_OK) {
+        tcp_abort(tpcb);
+        return ERR_ABRT;
     }
-    
     return ERR_OK;
 }
 
+// Conexão abortada (RST ou falta de memória): o lwIP já liberou o PCB, só o slot volta
+static void http_err(void *arg, err_t err) {
+    printf("AVISO: Conexão HTTP abortada: %d\n", err);
+    http_conn_release((struct http_state *)arg);
+}
+
+// Registra uma latência HTTP e publica as medições (só a thread tcpip chama)
+static void http_timing_add(TimingStats *stats, uint64_t start_us) {
+    timing_stats_add(stats, (uint32_t)(time_us_64() - start_us));
+    seqlock_write(&http_timing_lock, &http_timing, &http_timing_local, sizeof(http_timing_local));
+}
+
 static err_t connection_callback(void *arg, struct tcp_pcb *newpcb, err_t err) {
     if (err != ERR_OK || newpcb == NULL) {
         printf("ERRO: Falha na conexão TCP: %d\n", err);
         return ERR_VAL;
     }
     
+    // O slot acompanha a conexão. Pool cheio: fecha a conexão ociosa mais antiga; se
+    // todas estiverem ocupadas, a conexão fica sem slot e a requisição recebe 503
+    struct http_state *hs = http_conn_acquire(newpcb);
+    if (!hs) {
+        struct http_state *idle = http_conn_oldest_idle();
+        if (idle) {
+            printf("AVISO: Pool HTTP cheio, fechando conexão ociosa (slot %u)\n", idle->slot);
+            http_finish(idle->pcb, idle);
+            hs = http_conn_acquire(newpcb);
+        }
+    }
+
+    tcp_arg(newpcb, hs);
     tcp_recv(newpcb, http_recv);
-    tcp_err(newpcb, NULL); // Define callback de erro se necessário
+    tcp_sent(newpcb, http_sent);
+    tcp_err(newpcb, http_err);     // Devolve o slot se a conexão cair
+    tcp_poll(newpcb, http_poll, 2); // A cada 1 s (2 ciclos do timer lento do TCP)
+    return ERR_OK;
+}
+
+// Uma vez por segundo: fecha a conexão sem tráfego há HTTP_IDLE_TIMEOUT_S e retoma um
+// envio que parou por falta de memória no lwIP
+static err_t http_poll(void *arg, struct tcp_pcb *tpcb) {
+    struct http_state *hs = (struct http_state *)arg;
+    if (!hs) {
+        return http_finish(tpcb, NULL);     // Sem slot e sem requisição: não espera
+    }
+    if (++hs->idle_polls >= HTTP_IDLE_TIMEOUT_S) {
+        return http_finish(tpcb, hs);
+    }
+    if (http_conn_busy(hs) && hs->part < hs->part_count) {
+        if (http_conn_pump(hs, tpcb) == ERR_OK) {
+            tcp_output(tpcb);
+        }
+    }
     return ERR_OK;
 }
 
 void start_http_server(void) {
+    http_conn_pool_init();
+    page_header_len = (size_t)snprintf(page_header, sizeof(page_header),
+                                       "HTTP/1.1 200 OK\r\n"
+                                       "Content-Type: text/html; charset=UTF-8\r\n"
+                                       "Content-Length: %u\r\n"
+                                       "Vary: Accept-Encoding\r\n"
+                                       "ETag: " HTML_BODY_ETAG "\r\n"
+                                       HTTP_CACHE_CONTROL,
+                                       (unsigned)HTML_BODY_LEN);
+    page_header_gz_len = (size_t)snprintf(page_header_gz, sizeof(page_header_gz),
+                                          "HTTP/1.1 200 OK\r\n"
+                                          "Content-Type: text/html; charset=UTF-8\r\n"
+                                          "Content-Encoding: gzip\r\n"
+                                          "Content-Length: %u\r\n"
+                                          "Vary: Accept-Encoding\r\n"
+                                          "ETag: " HTML_BODY_GZ_ETAG "\r\n"
+                                          HTTP_CACHE_CONTROL,
+                                          (unsigned)HTML_BODY_GZ_LEN);
+
     struct tcp_pcb *pcb = tcp_new();
     if (!pcb) {
         printf("ERRO: Falha ao criar PCB TCP\n");
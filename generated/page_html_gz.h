@@ -0,0 +1,191 @@
+// -------------------------------------------------- //
+// Gerado por tools/gzip_asset.py; não edite!          //
+// -------------------------------------------------- //
+
+#ifndef PAGE_HTML_GZ_H
+#define PAGE_HTML_GZ_H
+
+#include <stdint.h>
+
+// HTML_BODY (8592 bytes) comprimido com gzip: 2736 bytes
+#define HTML_BODY_GZ_LEN 2736u
+
+// ETags fortes (uma por codificação)
+#define HTML_BODY_ETAG "\"15df856f26f1f080\""
+#define HTML_BODY_GZ_ETAG "\"15df856f26f1f080-gz\""
+
+static const uint8_t HTML_BODY_GZ[2736] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x5a, 0xdb, 0x8e, 0xdb, 0xc6,
+    0x19, 0x7e, 0x15, 0x9a, 0x86, 0xb1, 0x22, 0x4a, 0x52, 0xd2, 0xae, 0xe5, 0xdd, 0x50, 0xcb, 0x4d,
+    0xed, 0xf5, 0x1a, 0x71, 0xe0, 0x53, 0xb3, 0x9b, 0x8b, 0x36, 0x08, 0x8c, 0x11, 0x39, 0x94, 0xc6,
+    0xe6, 0xc9, 0xc3, 0xa1, 0x56, 0x8a, 0xa0, 0xbb, 0x16, 0x68, 0x83, 0x00, 0x05, 0x1a, 0xf7, 0xa2,
+    0x69, 0x8b, 0x36, 0xe8, 0x45, 0xae, 0x02, 0x04, 0x08, 0x0a, 0xf4, 0xaa, 0x17, 0xdd, 0x37, 0xf1,
+    0x0b, 0xb4, 0x8f, 0xd0, 0x7f, 0x4e, 0x14, 0xa9, 0x95, 0x14, 0x26, 0x76, 0x8c, 0xec, 0x92, 0xff,
+    0xcc, 0x7f, 0x98, 0xef, 0x3f, 0x0e, 0xed, 0xe3, 0x1b, 0xf7, 0x9f, 0x9e, 0x5e, 0xfc, 0xf2, 0xd9,
+    0x99, 0x31, 0x61, 0x49, 0x7c, 0x72, 0xcc, 0x7f, 0x1a, 0x31, 0x4a, 0xc7, 0xbe, 0x99, 0x33, 0xe7,
+    0xde, 0x47, 0x26, 0x90, 0x30, 0x0a, 0x4f, 0x8e, 0x13, 0xcc, 0x90, 0x11, 0x4c, 0x10, 0x2d, 0x30,
+    0xf3, 0xcd, 0x8f, 0x2f, 0x1e, 0x38, 0x47, 0xa6, 0xa2, 0xa6, 0x28, 0xc1, 0xbe, 0x39, 0x25, 0xf8,
+    0x32, 0xcf, 0x28, 0x33, 0x8d, 0x20, 0x4b, 0x19, 0x4e, 0x61, 0xd7, 0x25, 0x09, 0xd9, 0xc4, 0x0f,
+    0xf1, 0x94, 0x04, 0xd8, 0x11, 0x2f, 0x36, 0x49, 0x09, 0x23, 0x28, 0x76, 0x8a, 0x00, 0xc5, 0xd8,
+    0xef, 0xbb, 0x3d, 0x10, 0xc2, 0x08, 0x8b, 0xf1, 0xc9, 0x59, 0xc1, 0xd0, 0xd5, 0x37, 0x57, 0xff,
+    0xc8, 0x8c, 0xc7, 0x98, 0xe1, 0x8c, 0x66, 0xf1, 0xd5, 0xf7, 0x63, 0x12, 0xa0, 0xe3, 0xae, 0x5c,
+    0x3f, 0x2e, 0x02, 0x4a, 0x72, 0x66, 0x14, 0x34, 0xf0, 0xcd, 0x09, 0x63, 0x79, 0xe1, 0x75, 0xbb,
+    0x41, 0x98, 0xba, 0x2f, 0x8a, 0x10, 0xc7, 0x64, 0x4a, 0xdd, 0x14, 0xb3, 0x6e, 0x9a, 0x27, 0x5d,
+    0x6e, 0x25, 0x03, 0x32, 0x88, 0xee, 0x4a, 0x26, 0x60, 0x66, 0x73, 0x90, 0x31, 0xca, 0xc2, 0xf9,
+    0x22, 0x02, 0xf3, 0x9c, 0x08, 0x25, 0x24, 0x9e, 0x7b, 0x77, 0x29, 0x18, 0x63, 0x17, 0x28, 0x2d,
+    0x9c, 0x02, 0x53, 0x12, 0x0d, 0x13, 0x44, 0xc7, 0x24, 0xf5, 0x7a, 0xc3, 0x1c, 0x85, 0x21, 0x49,
+    0xc7, 0x5e, 0x9f, 0xe2, 0x64, 0x38, 0x42, 0xc1, 0xcb, 0x31, 0xcd, 0xca, 0x34, 0xf4, 0x6e, 0x46,
+    0xbd, 0xe8, 0x76, 0x74, 0xb4, 0x9c, 0xf4, 0x17, 0x0c, 0xcf, 0x98, 0x83, 0x62, 0x32, 0x4e, 0xbd,
+    0x00, 0xce, 0x8b, 0xe9, 0x30, 0xc8, 0xe2, 0x8c, 0x7a, 0x37, 0x0f, 0x0e, 0x0e, 0x96, 0x2e, 0x1c,
+    0x87, 0x95, 0xc5, 0x86, 0x4d, 0x4a, 0x05, 0x17, 0x6c, 0xac, 0xf4, 0xb8, 0x03, 0xa1, 0x28, 0xa3,
+    0x21, 0xa6, 0x0e, 0x45, 0x21, 0x29, 0x0b, 0x6f, 0x90, 0xcf, 0xb4, 0x1c, 0x37, 0x7b, 0xb9, 0xa8,
+    0x5b, 0x11, 0xde, 0xc6, 0x61, 0x88, 0xb4, 0xc2, 0xfe, 0x60, 0x70, 0xb8, 0x7f, 0x5b, 0x71, 0x7b,
+    0xfd, 0x7c, 0x66, 0x14, 0x59, 0x4c, 0x42, 0xe3, 0x66, 0x70, 0x80, 0xef, 0x04, 0xa3, 0x4a, 0x08,
+    0x60, 0x4e, 0x59, 0x43, 0x4e, 0x74, 0x14, 0x1e, 0xae, 0xe4, 0x1c, 0xee, 0xf7, 0x83, 0x8d, 0x72,
+    0xa2, 0x41, 0x20, 0xe4, 0x04, 0x88, 0x86, 0x4d, 0xfe, 0x28, 0x5a, 0x33, 0xba, 0xdf, 0xcb, 0x67,
+    0x40, 0x9a, 0x39, 0xc5, 0x04, 0x85, 0xd9, 0xa5, 0xd7, 0x33, 0x7a, 0x06, 0xa7, 0x19, 0x74, 0x3c,
+    0x42, 0x9d, 0x9e, 0x2d, 0xfe, 0xb8, 0x7d, 0x6b, 0x85, 0xb0, 0x3c, 0x7a, 0x1d, 0x16, 0x54, 0xb2,
+    0x0c, 0x08, 0x33, 0x19, 0x34, 0xde, 0x9d, 0x5e, 0x4f, 0x20, 0x81, 0xd3, 0x22, 0xa3, 0xce, 0x14,
+    0xc5, 0x25, 0x2e, 0x16, 0x21, 0x29, 0xf2, 0x18, 0xcd, 0xbd, 0x31, 0x25, 0xe1, 0x90, 0xff, 0x70,
+    0x18, 0x4e, 0x80, 0xc2, 0xb0, 0x03, 0xa7, 0x29, 0x93, 0xb4, 0xf0, 0x28, 0xce, 0x31, 0x62, 0x1d,
+    0x2e, 0xcd, 0x89, 0x08, 0xb3, 0x13, 0x92, 0x82, 0xd0, 0x4e, 0x7f, 0x00, 0xe2, 0xec, 0x7e, 0x44,
+    0x2d, 0x6b, 0x38, 0x46, 0xb9, 0x74, 0xb1, 0x88, 0x8a, 0x82, 0x7c, 0x86, 0xc1, 0x9e, 0x7d, 0x4e,
+    0xb8, 0xe6, 0xb8, 0xca, 0x00, 0x02, 0x8a, 0x16, 0xdb, 0xe3, 0xe3, 0x28, 0x7a, 0x2f, 0x42, 0x6b,
+    0xa0, 0x1c, 0x09, 0x4c, 0x04, 0xaa, 0xfb, 0x2b, 0x54, 0xf1, 0x7b, 0x38, 0xc0, 0x51, 0x43, 0xae,
+    0x76, 0x91, 0xe4, 0x56, 0x6e, 0x09, 0x83, 0x83, 0xc1, 0xed, 0xc1, 0x70, 0x0d, 0xf7, 0x41, 0x34,
+    0x58, 0x46, 0x19, 0x4d, 0xd6, 0x90, 0x50, 0x07, 0x5a, 0xba, 0x7c, 0xcd, 0xe1, 0xfb, 0xf3, 0x36,
+    0x58, 0x01, 0x1c, 0x06, 0xfc, 0x2f, 0xf8, 0xa5, 0x43, 0xc4, 0xd9, 0x85, 0x51, 0x85, 0x46, 0x20,
+    0x46, 0x23, 0x1c, 0xcb, 0x04, 0xba, 0xc4, 0x64, 0x3c, 0x61, 0xde, 0x28, 0x8b, 0xc3, 0x25, 0x49,
+    0xf3, 0x92, 0x2d, 0x9a, 0x91, 0x5c, 0xc3, 0x73, 0x15, 0xd8, 0x8d, 0xd0, 0x0c, 0x82, 0x35, 0x90,
+    0x6e, 0x83, 0x93, 0x47, 0x25, 0x63, 0x59, 0xba, 0x92, 0x75, 0xb8, 0x51, 0x58, 0x0d, 0x88, 0x5e,
+    0xef, 0x70, 0x04, 0x31, 0xa8, 0x90, 0x5a, 0x85, 0xa3, 0x97, 0x66, 0x29, 0xbe, 0x9e, 0x4f, 0xc3,
+    0xa0, 0xa4, 0x80, 0xb5, 0x97, 0x67, 0x44, 0x9c, 0x48, 0xea, 0xf3, 0x26, 0xd9, 0x14, 0xd3, 0x45,
+    0x53, 0xee, 0xe0, 0xce, 0x08, 0xd2, 0x58, 0x6e, 0x58, 0xc3, 0x31, 0x8a, 0xf1, 0xac, 0x86, 0xd4,
+    0x8b, 0xb2, 0x60, 0x24, 0x9a, 0x3b, 0xaa, 0xf0, 0x69, 0xb4, 0x7e, 0x9e, 0xe0, 0x90, 0xa0, 0xce,
+    0x2a, 0x8e, 0x07, 0x3c, 0x8e, 0xad, 0xc5, 0x5a, 0x20, 0x6f, 0xf5, 0x47, 0xc3, 0x85, 0xdb, 0x77,
+    0x2d, 0xa1, 0xca, 0x89, 0xea, 0x76, 0xdc, 0x95, 0xa5, 0x9a, 0x57, 0x39, 0x28, 0xdb, 0xfd, 0x93,
+    0xff, 0xfd, 0xed, 0x8b, 0xaf, 0xff, 0xfb, 0xaf, 0xdf, 0x1b, 0xdb, 0x4b, 0x2b, 0x6c, 0x3a, 0x0e,
+    0xc9, 0xd4, 0x20, 0xa1, 0x6f, 0xca, 0x1a, 0xe1, 0x8c, 0x10, 0x85, 0x12, 0x1e, 0xa3, 0xa2, 0xd0,
+    0x24, 0x23, 0x7b, 0x69, 0x9e, 0x9c, 0x22, 0x4a, 0xf1, 0x18, 0xa5, 0x61, 0x66, 0x84, 0x90, 0xd7,
+    0x85, 0xeb, 0xba, 0xc7, 0x5d, 0x60, 0x95, 0xfc, 0x6a, 0x3f, 0x2f, 0x0f, 0xbc, 0x63, 0xec, 0x83,
+    0xea, 0x2f, 0x3f, 0x37, 0x1e, 0x61, 0xc2, 0x4a, 0x8a, 0x0a, 0x03, 0xf6, 0x1b, 0xe7, 0xe2, 0xd0,
+    0xb8, 0x00, 0xa5, 0xfb, 0x0d, 0xa6, 0x06, 0x1a, 0xe6, 0xa6, 0x25, 0x1e, 0x83, 0xa6, 0xb0, 0x91,
+    0x03, 0x20, 0x5f, 0xc5, 0xbe, 0xea, 0x84, 0x50, 0xdf, 0x69, 0x96, 0x8e, 0x4f, 0x2e, 0x60, 0x1d,
+    0x53, 0xc4, 0xb5, 0x72, 0x54, 0x04, 0x6d, 0x65, 0x26, 0xb4, 0x81, 0x1c, 0xa5, 0x95, 0x20, 0xf3,
+    0xc4, 0x71, 0x60, 0x17, 0x90, 0x4e, 0xfe, 0xf3, 0xdd, 0xa9, 0xda, 0x76, 0xed, 0x4c, 0xd7, 0x6c,
+    0x98, 0x94, 0x09, 0x09, 0x09, 0x9b, 0x37, 0xed, 0xf8, 0xc3, 0x37, 0x95, 0x11, 0x1f, 0xc3, 0x3a,
+    0x0a, 0xf1, 0x6e, 0x03, 0xb4, 0x94, 0x9a, 0x11, 0xb7, 0x5a, 0x9b, 0x90, 0x03, 0x8e, 0x45, 0x49,
+    0x71, 0xd3, 0x84, 0x2f, 0x7f, 0x5b, 0x99, 0xf0, 0x8c, 0x6f, 0x00, 0x87, 0xef, 0xb6, 0x41, 0x8b,
+    0xa9, 0xd9, 0x60, 0x4c, 0x9e, 0xa1, 0xd6, 0x66, 0xa0, 0x18, 0x5a, 0x73, 0x19, 0x36, 0xcc, 0x78,
+    0xf3, 0xe7, 0xef, 0xea, 0x0e, 0xb9, 0xab, 0xb6, 0xec, 0x36, 0x44, 0x0b, 0xaa, 0x1b, 0x92, 0x34,
+    0xcc, 0xd8, 0x62, 0x52, 0x23, 0xe0, 0x7e, 0x67, 0x7c, 0x40, 0x0a, 0x76, 0xf5, 0x3d, 0x25, 0x01,
+    0x04, 0x29, 0xae, 0xc2, 0x4f, 0x46, 0x5c, 0x80, 0xd2, 0x29, 0x84, 0xa2, 0x88, 0x74, 0x71, 0x90,
+    0x53, 0x3e, 0x26, 0x98, 0xc6, 0x44, 0x14, 0x32, 0xdf, 0xdc, 0xef, 0xf1, 0x59, 0xa4, 0x2b, 0xb7,
+    0xed, 0x54, 0xf5, 0xe6, 0xab, 0x3f, 0xf1, 0x23, 0x9e, 0x66, 0x69, 0x44, 0xc6, 0xa0, 0x00, 0x52,
+    0xeb, 0x9f, 0xb8, 0x10, 0x1a, 0x49, 0x02, 0x50, 0x28, 0x85, 0x3c, 0x79, 0x85, 0xba, 0x40, 0x6c,
+    0x74, 0xf8, 0x7b, 0x33, 0xbc, 0x57, 0xe9, 0x0d, 0x74, 0x51, 0x5b, 0x0d, 0x20, 0xf9, 0x26, 0xf4,
+    0xa9, 0xe7, 0x32, 0x40, 0x75, 0x7c, 0xf3, 0xb8, 0x76, 0x8d, 0xc7, 0x57, 0xdf, 0xa6, 0x24, 0x41,
+    0x46, 0x07, 0xc2, 0xd5, 0xf2, 0x8e, 0xbb, 0x82, 0xe5, 0xe4, 0x58, 0x94, 0x5f, 0x83, 0xcd, 0x73,
+    0x98, 0xc2, 0xd2, 0x32, 0x19, 0x61, 0x2a, 0xdd, 0x53, 0x89, 0x51, 0x13, 0xda, 0xea, 0xbd, 0x60,
+    0x38, 0xf7, 0x4d, 0xe8, 0xc2, 0xa6, 0x41, 0xf1, 0xab, 0x92, 0x50, 0x1c, 0x6e, 0x38, 0xf1, 0x56,
+    0xf3, 0xd0, 0x6c, 0x8b, 0x79, 0x5f, 0xcf, 0x7e, 0x8c, 0x79, 0x5a, 0x8c, 0x36, 0xaf, 0x7a, 0x7f,
+    0x4b, 0xf3, 0xe0, 0x98, 0x90, 0x5d, 0xa6, 0x4c, 0x4a, 0x95, 0x8c, 0x2b, 0xec, 0x6e, 0xb5, 0x44,
+    0x8e, 0x8b, 0xa8, 0x01, 0x27, 0x5e, 0x6b, 0x86, 0x01, 0x0d, 0x9e, 0xe0, 0x37, 0x9a, 0xf9, 0x66,
+    0x1f, 0x62, 0xe7, 0xa7, 0x22, 0xb9, 0xc9, 0x54, 0x85, 0xe3, 0xad, 0x96, 0x28, 0xd6, 0x4d, 0xd5,
+    0xaf, 0xef, 0xdc, 0x54, 0xc0, 0x40, 0xd4, 0x0b, 0x53, 0x56, 0x1a, 0x5d, 0x61, 0x56, 0xc0, 0x42,
+    0xe5, 0x68, 0x09, 0xad, 0x94, 0x53, 0x03, 0x57, 0x11, 0xde, 0x3e, 0x2c, 0xb7, 0x58, 0xa8, 0xf0,
+    0x6c, 0x69, 0x61, 0x25, 0xa7, 0x86, 0xe9, 0xbb, 0xb1, 0x10, 0x8e, 0x0a, 0xa5, 0xce, 0xd4, 0x45,
+    0x52, 0x17, 0xc7, 0x15, 0x86, 0x49, 0x4b, 0x04, 0xb9, 0x94, 0x1a, 0x7e, 0xe2, 0xf5, 0xed, 0xd1,
+    0xdb, 0x62, 0x9b, 0x42, 0x2f, 0x69, 0x89, 0x5d, 0xdd, 0x36, 0xfd, 0xfa, 0x76, 0xb6, 0xbd, 0x4a,
+    0x27, 0xa2, 0xd6, 0x7c, 0xbe, 0xf2, 0x29, 0xca, 0x8c, 0x27, 0x57, 0xdf, 0x4e, 0x61, 0x07, 0x0c,
+    0x24, 0x8f, 0x11, 0x35, 0x1c, 0xe3, 0x17, 0x4f, 0x3e, 0x68, 0xeb, 0x62, 0x2e, 0x50, 0x99, 0x28,
+    0x1e, 0xb5, 0x79, 0x3d, 0x9d, 0x2d, 0x47, 0x87, 0xab, 0x7c, 0x39, 0x1a, 0xec, 0x34, 0xba, 0x3e,
+    0x20, 0x82, 0xd9, 0xf2, 0x55, 0xe9, 0x2c, 0xca, 0x11, 0x34, 0x04, 0x91, 0xde, 0xff, 0x36, 0xce,
+    0x51, 0x3c, 0x05, 0x43, 0xab, 0x1e, 0x21, 0x77, 0xae, 0x71, 0xc8, 0x17, 0x69, 0x25, 0x9c, 0x15,
+    0x33, 0x67, 0xc4, 0x52, 0x2e, 0xe0, 0xf5, 0xaf, 0x8d, 0x8f, 0xf8, 0x3b, 0x48, 0x78, 0x86, 0x42,
+    0x2a, 0x7a, 0xfb, 0x0f, 0x4a, 0x60, 0xd9, 0x78, 0x1c, 0x63, 0x47, 0xdc, 0x29, 0x44, 0x5a, 0xbc,
+    0x7e, 0xcd, 0x1d, 0x8b, 0x69, 0x0a, 0x62, 0xee, 0x72, 0x2a, 0xaa, 0x19, 0xa2, 0x7a, 0x2c, 0xf7,
+    0x82, 0x7e, 0x51, 0xd7, 0xe7, 0x18, 0x33, 0x43, 0x0a, 0x39, 0x4b, 0xd1, 0x28, 0xc6, 0xa1, 0xcf,
+    0x68, 0x89, 0x6d, 0x5e, 0xad, 0x79, 0xcb, 0xf5, 0x3f, 0xf9, 0xd4, 0x86, 0xa2, 0xa3, 0x1f, 0x45,
+    0xae, 0xe8, 0x17, 0xe1, 0x89, 0x02, 0x9e, 0x60, 0x44, 0x4f, 0x0b, 0x26, 0x3e, 0x21, 0xb0, 0x53,
+    0x36, 0xf3, 0xc3, 0x2c, 0x28, 0x13, 0x18, 0x94, 0xdd, 0x31, 0x66, 0x67, 0x31, 0xe6, 0x8f, 0xf7,
+    0xe6, 0x0f, 0xc3, 0xce, 0x5e, 0xad, 0x3b, 0xef, 0x59, 0x7c, 0xf5, 0x94, 0x8f, 0xd5, 0x33, 0xd6,
+    0xd9, 0xdb, 0x0f, 0xf7, 0xac, 0xba, 0x18, 0x3f, 0xc5, 0x97, 0x86, 0xd8, 0xd8, 0xd1, 0x62, 0xed,
+    0x05, 0x47, 0xc1, 0xdb, 0x8b, 0x49, 0x8a, 0xf7, 0xec, 0x10, 0x31, 0xe4, 0x2d, 0xa4, 0x09, 0x9e,
+    0xfc, 0x25, 0x68, 0x80, 0x63, 0xe1, 0x7d, 0x22, 0x17, 0xbc, 0xbd, 0xda, 0xd0, 0x28, 0x7b, 0x97,
+    0x62, 0xd4, 0xc7, 0xb3, 0xe5, 0x2d, 0xe2, 0x54, 0x5c, 0x31, 0xf6, 0x20, 0x0a, 0xf6, 0xec, 0x88,
+    0xc4, 0xb1, 0x17, 0xa1, 0xb8, 0xc0, 0x4b, 0x5b, 0x8b, 0xd1, 0xe5, 0x1b, 0xca, 0xb6, 0x12, 0xa0,
+    0x30, 0x69, 0xf2, 0x8f, 0x60, 0xcc, 0xdd, 0x2c, 0xa0, 0x0a, 0x6e, 0x11, 0xc5, 0x4a, 0x46, 0x05,
+    0x66, 0x53, 0xca, 0x98, 0x62, 0x9c, 0x36, 0xc4, 0x7c, 0xba, 0xb4, 0xb3, 0x9c, 0x11, 0x40, 0xc7,
+    0x5b, 0x00, 0x4f, 0x0e, 0x0f, 0x64, 0x8a, 0x3d, 0xe1, 0x28, 0xf1, 0xb5, 0x05, 0xe8, 0x73, 0x6f,
+    0x31, 0xc2, 0x70, 0xcb, 0xbe, 0xcb, 0x7e, 0x85, 0x69, 0xa6, 0x18, 0xe1, 0x3f, 0x6b, 0xc8, 0x3d,
+    0x0c, 0xf1, 0xcc, 0xce, 0xf1, 0x2b, 0xdf, 0xe9, 0x0f, 0x51, 0x31, 0x4f, 0x03, 0x23, 0x2a, 0xd3,
+    0x80, 0x4b, 0x34, 0x22, 0xcc, 0x82, 0xc9, 0x7d, 0x30, 0xa7, 0x63, 0x2d, 0x18, 0x9d, 0x2f, 0xa4,
+    0x0f, 0x40, 0x8b, 0x8f, 0x2e, 0x11, 0x61, 0x72, 0xbd, 0x63, 0x76, 0x51, 0x4e, 0xba, 0x45, 0x8a,
+    0xf2, 0x62, 0x92, 0x31, 0xd3, 0x1a, 0x92, 0xa8, 0x73, 0x03, 0x36, 0xb9, 0xd9, 0x4b, 0x8b, 0x4d,
+    0x68, 0x76, 0x69, 0x70, 0x7f, 0x9d, 0x51, 0x9a, 0xd1, 0x8e, 0xc9, 0x7f, 0xf1, 0x2c, 0x1e, 0x95,
+    0x60, 0x1c, 0x95, 0x77, 0x0a, 0x71, 0x4f, 0x28, 0xd4, 0x3d, 0xc1, 0xd4, 0xae, 0xe6, 0x02, 0x95,
+    0x1e, 0x2e, 0xec, 0x45, 0x91, 0xa5, 0x1d, 0xcb, 0xa6, 0x3e, 0xa7, 0xbb, 0x14, 0x6e, 0x3c, 0x70,
+    0x51, 0xb4, 0x63, 0x9e, 0x55, 0x85, 0xa4, 0xc9, 0x67, 0x5b, 0x5e, 0x5e, 0x24, 0x49, 0x3e, 0x73,
+    0x83, 0xa8, 0xb5, 0xd8, 0x16, 0x79, 0xf2, 0x52, 0x60, 0xb9, 0x3c, 0xd8, 0x4e, 0xd5, 0x37, 0x2c,
+    0xea, 0xb2, 0x2a, 0x3a, 0xb0, 0xcb, 0xb2, 0x07, 0x64, 0x86, 0xc3, 0x4e, 0xdf, 0x1a, 0x6e, 0x15,
+    0x52, 0x0d, 0xf6, 0xeb, 0x82, 0xf4, 0x42, 0x2b, 0x29, 0xd5, 0x68, 0xbe, 0x2e, 0x45, 0x2f, 0xb4,
+    0x92, 0x52, 0xcd, 0xd5, 0xeb, 0x52, 0xf4, 0x42, 0x5d, 0x0a, 0x80, 0x23, 0xb1, 0xc2, 0xaf, 0x6e,
+    0xf8, 0xbe, 0x0a, 0x06, 0x6b, 0xa1, 0xa3, 0x42, 0xaf, 0x0d, 0x65, 0x1e, 0xb9, 0x79, 0x59, 0x4c,
+    0x3a, 0xdc, 0xa1, 0x10, 0x17, 0xb8, 0x03, 0x0a, 0xb2, 0x47, 0x19, 0x0f, 0xb3, 0x0b, 0x92, 0xe0,
+    0x73, 0x46, 0xc1, 0x29, 0x1d, 0x4b, 0x08, 0x55, 0xfb, 0x63, 0x9c, 0x8e, 0xd9, 0xe4, 0xa4, 0xdf,
+    0xb3, 0x54, 0x42, 0xba, 0xc5, 0x84, 0x44, 0xac, 0x63, 0x0d, 0x75, 0x9e, 0x55, 0x04, 0x95, 0x37,
+    0xd5, 0x7b, 0x95, 0x03, 0x9a, 0xb2, 0xac, 0x58, 0x84, 0x15, 0x0d, 0x27, 0xad, 0xd8, 0xd5, 0x9a,
+    0xc6, 0xbd, 0x2e, 0x47, 0x2d, 0x69, 0x30, 0x21, 0xd4, 0xc4, 0x37, 0xc3, 0x32, 0x0f, 0xc5, 0x61,
+    0x86, 0xcb, 0xe5, 0x56, 0x4c, 0xab, 0x29, 0xda, 0x72, 0xc5, 0x95, 0xd5, 0x97, 0xe1, 0xe6, 0x6a,
+    0xfa, 0x76, 0x6f, 0x54, 0x03, 0xee, 0x3a, 0xa7, 0xa2, 0x0f, 0x77, 0xea, 0xe4, 0x53, 0xdd, 0x06,
+    0x95, 0x40, 0xde, 0xad, 0x71, 0x13, 0x9f, 0x24, 0xef, 0xd6, 0x27, 0x27, 0x9e, 0x0d, 0x1a, 0xc5,
+    0xc2, 0x6e, 0x9d, 0x9b, 0x79, 0xf5, 0xc2, 0x6e, 0xbd, 0x7c, 0x5e, 0xd8, 0xa0, 0x15, 0xc8, 0xbb,
+    0x75, 0x6e, 0xe2, 0x93, 0xe4, 0xed, 0x7c, 0xbc, 0xf9, 0xaf, 0xf1, 0x00, 0x69, 0xd8, 0x6c, 0x75,
+    0x22, 0xf0, 0x05, 0xc9, 0xc5, 0x92, 0xa4, 0x0b, 0x93, 0x28, 0x2a, 0xf7, 0x10, 0xdd, 0xda, 0xcb,
+    0xea, 0xdf, 0x54, 0x2c, 0xd1, 0x2e, 0x1f, 0xc2, 0x0f, 0x7f, 0x67, 0x01, 0x92, 0x97, 0x69, 0x8b,
+    0x37, 0xd4, 0xdd, 0x9b, 0x9b, 0xdf, 0x21, 0x2c, 0xd1, 0x76, 0x77, 0x73, 0x34, 0x3f, 0x1b, 0x58,
+    0x36, 0x60, 0xb3, 0x9b, 0xa1, 0x79, 0xc1, 0x97, 0x05, 0x5d, 0x1e, 0xc9, 0x5a, 0x54, 0xa7, 0x77,
+    0xc5, 0x20, 0xf4, 0x44, 0x4c, 0x53, 0xab, 0x0f, 0x46, 0xc3, 0xd5, 0x7a, 0xbd, 0xf4, 0x98, 0x77,
+    0xc7, 0x25, 0x5c, 0xa4, 0xc5, 0x77, 0x24, 0x64, 0xe4, 0x14, 0x8a, 0x05, 0x81, 0xb6, 0x1b, 0xcb,
+    0xab, 0xba, 0xeb, 0xba, 0xe6, 0x90, 0x62, 0x78, 0x4c, 0x97, 0x1a, 0x2d, 0x29, 0xfe, 0x11, 0xcf,
+    0x5a, 0x39, 0xce, 0x70, 0xb3, 0xc0, 0x19, 0xa6, 0xad, 0x4c, 0xb9, 0x96, 0xfc, 0xed, 0xb8, 0x9a,
+    0x65, 0xa1, 0x1d, 0xcf, 0xaa, 0x5e, 0x28, 0xe8, 0x7e, 0x98, 0x45, 0x43, 0x28, 0xeb, 0xab, 0xa6,
+    0xc5, 0xcf, 0xa1, 0x27, 0xfe, 0x54, 0x08, 0xdf, 0xfc, 0xe5, 0x37, 0xc6, 0x45, 0xc6, 0x7b, 0x65,
+    0xad, 0x5d, 0x8a, 0x66, 0x0d, 0xbd, 0x5a, 0x20, 0x9b, 0xc2, 0x08, 0x87, 0x62, 0xee, 0x47, 0x6c,
+    0x2e, 0xa1, 0xd4, 0xe2, 0x9d, 0xaa, 0xa4, 0xc5, 0x5b, 0xb5, 0x7d, 0xf5, 0x77, 0x7e, 0x1f, 0x30,
+    0x7f, 0x56, 0xcb, 0x83, 0x04, 0x60, 0x40, 0x63, 0x18, 0x1d, 0x02, 0xc4, 0x1b, 0x3f, 0xa6, 0xd0,
+    0x55, 0x55, 0x4e, 0xb4, 0xcb, 0x85, 0x61, 0xb1, 0xc3, 0x8e, 0x35, 0xfd, 0x7f, 0xfd, 0x42, 0xcc,
+    0x0c, 0xfc, 0xfb, 0x0a, 0xe8, 0xc0, 0x33, 0x98, 0x90, 0x3c, 0x30, 0x07, 0x94, 0xae, 0xec, 0xd8,
+    0xaa, 0xb4, 0xfe, 0xed, 0xc5, 0x72, 0x51, 0x18, 0x9e, 0x4d, 0x61, 0x8d, 0x3b, 0x0c, 0xa7, 0x18,
+    0xc6, 0x10, 0x35, 0xa1, 0xdb, 0x72, 0xe0, 0xc1, 0xfe, 0xc9, 0x02, 0x73, 0x2f, 0xf3, 0x4d, 0xf7,
+    0x71, 0x84, 0xca, 0x58, 0x34, 0xa8, 0x6a, 0xe4, 0xe1, 0x72, 0xf8, 0x1c, 0xe4, 0x2f, 0x74, 0xb9,
+    0xf7, 0x72, 0xfe, 0x57, 0x62, 0x0f, 0xe2, 0x0c, 0xb1, 0x4e, 0xeb, 0x9e, 0x61, 0xd9, 0xba, 0xe6,
+    0xb7, 0x63, 0x5f, 0x6b, 0x1c, 0x96, 0xad, 0x2a, 0x7f, 0x6b, 0xe5, 0xb5, 0x26, 0x20, 0x75, 0xb7,
+    0x66, 0x6e, 0x76, 0x10, 0xa9, 0x59, 0xa4, 0x41, 0x6b, 0xdd, 0x8d, 0x66, 0x20, 0xb5, 0xff, 0x08,
+    0x01, 0xeb, 0xdd, 0x44, 0x5a, 0x00, 0x59, 0xd5, 0x5a, 0x7f, 0xad, 0x31, 0x48, 0xed, 0xad, 0x99,
+    0x9b, 0x5d, 0xc5, 0xb2, 0xa1, 0x37, 0xb4, 0x62, 0xac, 0xb5, 0x15, 0x6b, 0x39, 0xdc, 0x36, 0x2c,
+    0xcb, 0x86, 0x63, 0xda, 0x8b, 0x04, 0xb3, 0x49, 0x16, 0x7a, 0xe6, 0xb3, 0xa7, 0xe7, 0x17, 0xa6,
+    0xcd, 0xbf, 0xe1, 0x63, 0x0a, 0xc3, 0xba, 0xa9, 0x52, 0xc0, 0xb9, 0x80, 0x1b, 0x8d, 0xe9, 0x99,
+    0x28, 0xcf, 0x63, 0x02, 0x09, 0x07, 0x49, 0xde, 0xe5, 0x43, 0xb0, 0xb9, 0xb4, 0xf9, 0x97, 0x7e,
+    0xef, 0xc3, 0xf3, 0xa7, 0x4f, 0x60, 0xc0, 0xe5, 0x13, 0x17, 0x89, 0xe6, 0x1d, 0x1d, 0xa2, 0xd6,
+    0x12, 0x86, 0x64, 0x5c, 0x40, 0x04, 0x5f, 0x1b, 0x9e, 0xc5, 0x1c, 0x2c, 0x96, 0xd4, 0x60, 0xec,
+    0xfb, 0xfc, 0xae, 0x1a, 0x04, 0x02, 0x67, 0x91, 0x86, 0x1d, 0x51, 0x65, 0xd4, 0x5d, 0xd5, 0x80,
+    0x3d, 0x28, 0x26, 0x9f, 0x89, 0x19, 0x3d, 0xc8, 0x12, 0x03, 0xf6, 0xc2, 0xd6, 0xec, 0x06, 0x24,
+    0x32, 0xaf, 0x2e, 0x86, 0x66, 0x51, 0xa9, 0xca, 0xd3, 0x53, 0xc9, 0x57, 0x19, 0x6a, 0xd5, 0x2b,
+    0xc5, 0xda, 0xee, 0x7a, 0x62, 0xf3, 0x1b, 0x41, 0x21, 0xef, 0xc9, 0xb1, 0xd4, 0x6d, 0x5a, 0xfc,
+    0x7a, 0xb2, 0x15, 0xea, 0xd5, 0x1d, 0x79, 0x53, 0x76, 0x07, 0x00, 0xd8, 0x4b, 0x95, 0xdc, 0x1d,
+    0x0b, 0x92, 0x1b, 0x0e, 0x2e, 0x2a, 0x02, 0x4d, 0x3a, 0xe6, 0x7d, 0x60, 0x7d, 0x81, 0x0c, 0xaa,
+    0x6e, 0xd5, 0x4c, 0x57, 0xd4, 0x58, 0x1f, 0x1a, 0x9e, 0xc1, 0x87, 0xa2, 0xb8, 0xe6, 0xf2, 0xca,
+    0xfd, 0xbe, 0x69, 0x59, 0xb5, 0xfb, 0xcf, 0x9a, 0x43, 0x85, 0xa4, 0xe7, 0x9b, 0xdd, 0x7a, 0xcd,
+    0x19, 0xad, 0x5c, 0xb1, 0xd8, 0xe0, 0x0b, 0x69, 0x2f, 0xd8, 0xca, 0xd1, 0xaf, 0x5d, 0xcc, 0x54,
+    0x31, 0xbe, 0x86, 0x2e, 0x20, 0xaa, 0x8f, 0xd8, 0x0e, 0xd2, 0xe6, 0x47, 0x83, 0x56, 0xb0, 0x6e,
+    0xc7, 0x44, 0x0a, 0x7b, 0xae, 0x84, 0xbd, 0x43, 0x50, 0xaa, 0xf1, 0x4c, 0x6d, 0x14, 0xc4, 0xe7,
+    0x7a, 0x40, 0x93, 0x20, 0x34, 0x36, 0xbe, 0x6f, 0xaa, 0xcf, 0x1f, 0xe2, 0xab, 0x07, 0x84, 0x34,
+    0x99, 0x4a, 0x14, 0x3d, 0xbe, 0xf0, 0xc7, 0x6a, 0x21, 0xc4, 0xc5, 0x6a, 0x6d, 0x17, 0xaa, 0x48,
+    0x7f, 0x48, 0x41, 0x92, 0x53, 0xc2, 0x5a, 0xf3, 0xc8, 0x10, 0x50, 0x7f, 0xc8, 0xff, 0x26, 0x10,
+    0xa2, 0xa8, 0x53, 0xd1, 0xed, 0x83, 0x5e, 0xaf, 0x67, 0x0d, 0x57, 0xff, 0x34, 0xa1, 0x2b, 0xff,
+    0xbe, 0xae, 0x2b, 0xfe, 0x01, 0xc6, 0xff, 0x01, 0xfa, 0xa0, 0x71, 0xe9, 0x90, 0x21, 0x00, 0x00,
+};
+
+#endif // PAGE_HTML_GZ_H
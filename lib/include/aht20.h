@@ -10,18 +10,34 @@
 #define AHT20_CMD_TRIGGER   0xAC
 #define AHT20_CMD_RESET     0xBA
 
-// Estrutura para armazenar os valores de temperatura e umidade
+// Tempo típico de conversão após o comando de medição (datasheet: 80 ms)
+#define AHT20_CONVERSION_MS 80
+
+// Estrutura para armazenar os valores de temperatura e umidade (ponto fixo, sem float)
 typedef struct {
-    float temperature;
-    float humidity;
+    int32_t temperature;    // centi-°C
+    int32_t humidity;       // centi-%
 } AHT20_Data;
 
+// Resultado da coleta de uma medição disparada
+typedef enum {
+    AHT20_OK = 0,
+    AHT20_BUSY,
+    AHT20_ERROR
+} AHT20_Status;
+
 // Inicializa o sensor AHT20
 bool aht20_init(i2c_inst_t *i2c);
 
-// Faz a leitura de temperatura e umidade do AHT20
+// Faz a leitura de temperatura e umidade do AHT20 (bloqueante: dispara e aguarda a conversão)
 bool aht20_read(i2c_inst_t *i2c, AHT20_Data *data);
 
+// Dispara uma medição e retorna sem aguardar a conversão
+bool aht20_trigger(i2c_inst_t *i2c);
+
+// Coleta a medição disparada: status e 6 bytes de dados em uma única leitura I2C
+AHT20_Status aht20_collect(i2c_inst_t *i2c, AHT20_Data *data);
+
 // Reseta o sensor AHT20
 void aht20_reset(i2c_inst_t *i2c);
 
@@ -0,0 +1,53 @@
+#ifndef ALERT_FX_H
+#define ALERT_FX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Animações da matriz de LEDs e padrões do buzzer tocados em segundo plano por um
+// repeating timer: o loop principal só escolhe o efeito, nunca espera por ele.
+// O quadro base é o framebuffer do ws2812 desenhado pelo loop e publicado com
+// alert_fx_refresh; o timer é o único que chama ws2812_show*, lendo só o quadro
+// publicado e aplicando o efeito no momento do envio
+
+// Intervalo do timer (resolução dos padrões do buzzer)
+#define ALERT_FX_TICK_MS 10
+
+typedef enum {
+    ALERT_NONE = 0,      // Todos os sensores dentro dos limites
+    ALERT_WARNING,       // Um sensor fora dos limites
+    ALERT_CRITICAL       // Dois ou mais sensores fora dos limites
+} AlertSeverity;
+
+typedef enum {
+    LED_FX_STEADY = 0,   // Quadro base sem efeito
+    LED_FX_BLINK,        // Quadro base aceso/apagado
+    LED_FX_PULSE,        // Quadro base com brilho em rampa
+    LED_FX_RAINBOW       // Arco-íris girando (ignora o quadro base)
+} LedEffect;
+
+// Padrão do buzzer: 'beeps' bipes de on_ms/off_ms seguidos de pause_ms, repetido
+typedef struct {
+    uint16_t frequency;
+    uint16_t on_ms;
+    uint16_t off_ms;
+    uint8_t beeps;       // 0 = silêncio
+    uint16_t pause_ms;
+} BuzzerPattern;
+
+// Inicia o timer; a matriz e o PWM do buzzer já devem estar configurados
+void alert_fx_init(void);
+
+// Troca o efeito dos LEDs (reinicia a fase da animação)
+void alert_fx_set_led_effect(LedEffect effect);
+
+// Troca o padrão do buzzer (NULL = silêncio)
+void alert_fx_set_buzzer(const BuzzerPattern *pattern);
+
+// Escolhe efeito e padrão da severidade; não faz nada se ela não mudou
+void alert_fx_set_severity(AlertSeverity severity);
+
+// Publica o quadro base desenhado no framebuffer do ws2812; sai no próximo tick
+void alert_fx_refresh(void);
+
+#endif // ALERT_FX_H
@@ -0,0 +1,26 @@
+#ifndef ALTITUDE_H
+#define ALTITUDE_H
+
+#include <stdint.h>
+
+// Altitude barométrica sem ponto flutuante:
+//   h = 44330 m * (1 - (P / QNH)^0.1903)
+// tabelada em função da razão P / QNH e interpolada linearmente.
+// Erro máximo frente a pow() em double (varrido no host, QNH de 950 a 1050 hPa):
+//   ≤ 4 cm para P entre 800 e 1050 hPa;  ≤ 14 cm para P entre 300 e 1100 hPa.
+
+// Pressão ao nível do mar padrão (QNH inicial) em Pa
+#define ALTITUDE_STANDARD_QNH 101325
+
+// Faixa aceita para o QNH configurado (recordes meteorológicos com folga), em Pa
+#define ALTITUDE_QNH_MIN 87000
+#define ALTITUDE_QNH_MAX 108500
+
+/**
+ * Calcula a altitude em cm a partir da pressão e do QNH, ambos em Pa, sem divisão de 64 bits.
+ * Razões P / QNH fora de [0,25, 1,25] são saturadas nas extremidades da tabela; o QNH é
+ * saturado em [ALTITUDE_QNH_MIN, ALTITUDE_QNH_MAX], a faixa aceita na configuração
+ */
+int32_t altitude_from_pressure(int32_t pressure, int32_t qnh);
+
+#endif // ALTITUDE_H
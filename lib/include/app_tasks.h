@@ -0,0 +1,87 @@
+#ifndef APP_TASKS_H
+#define APP_TASKS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sensor_limits.h"
+#include "alert_fx.h"
+#include "data_store.h"
+
+// ============================================================================
+// TAREFAS DO FREERTOS
+// ============================================================================
+// Pipeline de uma leitura:
+//   núcleo 0                                                   | núcleo 1
+//   sensor --reading_queue--> alerta --display_queue--> display |
+//      |                          \--led_queue------> LEDs     |
+//      \--storage_ring (SPSC, sem trava)---------------------> armazenamento
+//                                                               --seqlock--> HTTP (tcpip)
+//   alerta <--seqlock (limites publicados pelo HTTP)------------------------/
+// A tarefa de sensores nunca espera: a fila e o anel são escritos sem timeout
+// (cheio = descarta e conta). Display e LEDs só precisam do estado mais recente,
+// então suas filas têm uma posição e são sobrescritas.
+// O armazenamento é dono do ReadingStore e publica um instantâneo da última leitura;
+// os callbacks HTTP (thread tcpip) são donos de sensor_limits e publicam os limites.
+// Nenhum dado cruza os núcleos por mutex.
+
+// Afinidade (máscara de núcleos)
+#define ACQ_CORE_MASK            (1u << 0)  // Aquisição, alerta, display e LEDs
+#define NET_CORE_MASK            (1u << 1)  // Wi-Fi, lwIP/HTTP, armazenamento e relatórios
+
+// Prioridades (maior = mais urgente)
+#define SENSOR_TASK_PRIORITY     (tskIDLE_PRIORITY + 6)
+#define ALERT_TASK_PRIORITY      (tskIDLE_PRIORITY + 5)
+#define LED_TASK_PRIORITY        (tskIDLE_PRIORITY + 4)
+#define DISPLAY_TASK_PRIORITY    (tskIDLE_PRIORITY + 4)
+// CYW43_TASK_PRIORITY (driver Wi-Fi) = +3, definido no CMakeLists.txt
+// TCPIP_THREAD_PRIO (lwIP/HTTP) = +2, definido em lwipopts.h
+#define STORAGE_TASK_PRIORITY    (tskIDLE_PRIORITY + 1)
+#define NETWORK_TASK_PRIORITY    (tskIDLE_PRIORITY + 1)
+
+// Pilhas em palavras de 32 bits
+#define SENSOR_TASK_STACK        1024
+#define ALERT_TASK_STACK         1024
+#define LED_TASK_STACK           512
+#define DISPLAY_TASK_STACK       768
+#define STORAGE_TASK_STACK       1024
+#define NETWORK_TASK_STACK       1024   // Inicializa Wi-Fi e servidor HTTP, depois imprime relatórios
+
+// Períodos
+#define SENSOR_PERIOD_MS         1500
+#define TASK_STATS_PERIOD_MS     10000
+
+// Profundidade das filas (o anel precisa ser potência de 2)
+#define READING_QUEUE_LENGTH     4
+#define STORAGE_RING_CAPACITY    8
+
+// Leitura compensada, saída da tarefa de sensores
+typedef struct {
+    uint32_t sequence;
+    int32_t temperature;        // centi-°C (média BMP280/AHT20)
+    int32_t humidity;           // centi-%
+    int32_t pressure;           // Pa
+    bool aht_ok;
+    uint32_t process_us;        // Tempo de CPU da tarefa de sensores no ciclo
+} SensorMessage;
+
+// Leitura avaliada contra os limites, saída da tarefa de alerta
+typedef struct {
+    SensorMessage reading;
+    int32_t altitude;           // cm, com o QNH configurado
+    LimitCheckResult check;
+    AlertSeverity severity;
+    SensorLimits limits;        // Cópia usada na avaliação (escala das barras de LEDs)
+} AlertMessage;
+
+// Última leitura publicada pelo armazenamento para os handlers HTTP (via seqlock)
+typedef struct {
+    bool valid;                 // Já existe ao menos uma leitura
+    uint32_t sequence;          // Publicações desde o boot (ETag das rotas JSON)
+    int count;                  // Leituras no ReadingStore
+    CodecSample last_sample;    // Ponto fixo, como armazenada
+    SensorReading last;         // Decodificada para o JSON
+} StationSnapshot;
+
+#endif // APP_TASKS_H
@@ -43,8 +43,67 @@
 #define REG_DIG_P9_LSB _u(0x9E)
 #define REG_DIG_P9_MSB _u(0x9F)
 
+#define REG_STATUS _u(0xF3)
+
 #define NUM_CALIB_PARAMS 24
 
+// Sobreamostragem de temperatura/pressão (campos osrs_t e osrs_p de ctrl_meas)
+typedef enum {
+    BMP280_OSRS_SKIP = 0,
+    BMP280_OSRS_X1   = 1,
+    BMP280_OSRS_X2   = 2,
+    BMP280_OSRS_X4   = 3,
+    BMP280_OSRS_X8   = 4,
+    BMP280_OSRS_X16  = 5
+} bmp280_osrs_t;
+
+// Coeficiente do filtro IIR (campo filter de config)
+typedef enum {
+    BMP280_FILTER_OFF = 0,
+    BMP280_FILTER_2   = 1,
+    BMP280_FILTER_4   = 2,
+    BMP280_FILTER_8   = 3,
+    BMP280_FILTER_16  = 4
+} bmp280_filter_t;
+
+// Tempo de espera entre conversões no modo normal (campo t_sb de config)
+typedef enum {
+    BMP280_STANDBY_0_5_MS  = 0,
+    BMP280_STANDBY_62_5_MS = 1,
+    BMP280_STANDBY_125_MS  = 2,
+    BMP280_STANDBY_250_MS  = 3,
+    BMP280_STANDBY_500_MS  = 4,
+    BMP280_STANDBY_1000_MS = 5,
+    BMP280_STANDBY_2000_MS = 6,
+    BMP280_STANDBY_4000_MS = 7
+} bmp280_standby_t;
+
+typedef enum {
+    BMP280_MODE_SLEEP  = 0,
+    BMP280_MODE_FORCED = 1,
+    BMP280_MODE_NORMAL = 3
+} bmp280_mode_t;
+
+typedef struct {
+    bmp280_osrs_t osrs_t;
+    bmp280_osrs_t osrs_p;
+    bmp280_filter_t filter;
+    bmp280_standby_t standby;
+    bmp280_mode_t mode;
+} bmp280_config_t;
+
+// Presets em modo normal: o sensor converte sozinho e o host só faz leituras em rajada
+typedef enum {
+    BMP280_PRESET_WEATHER = 0,  // T x1, P x4, IIR 16, 500 ms: baixo ruído e consumo, amostragem lenta
+    BMP280_PRESET_INDOOR,       // T x2, P x16, IIR 16, 62,5 ms: menor ruído, conversão mais longa
+    BMP280_PRESET_FAST          // T x1, P x2, IIR 4, 0,5 ms: resposta rápida, mais ruído
+} bmp280_preset_t;
+
+// Preset usado por bmp280_init (ver BMP280_PRESET no CMakeLists.txt)
+#ifndef BMP280_DEFAULT_PRESET
+#define BMP280_DEFAULT_PRESET BMP280_PRESET_WEATHER
+#endif
+
 struct bmp280_calib_param {
     uint16_t dig_t1;
     int16_t dig_t2;
@@ -63,10 +122,21 @@ struct bmp280_calib_param {
 
 //void bmp280_init(void);
 void bmp280_init(i2c_inst_t *i2c);
+void bmp280_configure(i2c_inst_t *i2c, const bmp280_config_t *config);
+bmp280_config_t bmp280_preset_config(bmp280_preset_t preset);
+void bmp280_apply_preset(i2c_inst_t *i2c, bmp280_preset_t preset);
+uint32_t bmp280_measurement_time_us(const bmp280_config_t *config);
+uint32_t bmp280_standby_time_us(bmp280_standby_t standby);
 void bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure);
 void bmp280_reset(i2c_inst_t *i2c);
 int32_t bmp280_convert_temp(int32_t temp, struct bmp280_calib_param* params);
 int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_calib_param* params);
+// Compensação conjunta: t_fine calculado uma vez; temperatura em centi-°C e pressão em Pa
+void bmp280_compensate(int32_t raw_temp, int32_t raw_pressure, const struct bmp280_calib_param* params,
+                       int32_t* temp, uint32_t* pressure);
+// Compensação de um lote de amostras brutas (sobreamostragem ou reprocessamento) em um único laço
+void bmp280_compensate_burst(const int32_t* raw_temp, const int32_t* raw_pressure, size_t count,
+                             const struct bmp280_calib_param* params, int32_t* temp, uint32_t* pressure);
 void bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params);
 
 #endif
@@ -4,35 +4,236 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "pico/stdlib.h"
+#include "reading_codec.h"
 
-#define MAX_READINGS 30
+// Capacidade do buffer circular de leituras recentes, definida em tempo de compilação (ver CMakeLists.txt).
+// Cada bloco completo é selado e comprimido no arquivo, que guarda o histórico longo
+#ifndef READING_STORE_CAPACITY
+#define READING_STORE_CAPACITY 512
+#endif
+
+// Arquivo de blocos comprimidos: área de bytes e número máximo de blocos
+#ifndef READING_ARCHIVE_BYTES
+#define READING_ARCHIVE_BYTES 32768
+#endif
+#ifndef READING_ARCHIVE_BLOCKS
+#define READING_ARCHIVE_BLOCKS 384
+#endif
+
+// Leituras por bloco: cada bloco guarda um timestamp base de 32 bits
+#ifndef READING_BLOCK_SIZE
+#define READING_BLOCK_SIZE 64
+#endif
+#define READING_BLOCK_COUNT ((READING_STORE_CAPACITY + READING_BLOCK_SIZE - 1) / READING_BLOCK_SIZE)
+
+#define MAX_READINGS READING_STORE_CAPACITY
+
+// Histórico agregado: buckets por minuto e por hora (ver CMakeLists.txt)
+#ifndef HISTORY_MINUTE_BUCKETS
+#define HISTORY_MINUTE_BUCKETS 60    // 1 hora
+#endif
+#ifndef HISTORY_HOUR_BUCKETS
+#define HISTORY_HOUR_BUCKETS 72      // 3 dias
+#endif
+
+// Teto de SRAM dos dois níveis agregados, conferido na compilação (data_store.c).
+// Com 24 bytes por bucket, o padrão ocupa (60 + 72) * 24 = 3168 bytes
+#ifndef HISTORY_ROLLUP_BUDGET_BYTES
+#define HISTORY_ROLLUP_BUDGET_BYTES 4096
+#endif
+
+// Escalas de ponto fixo usadas nas leituras compactadas e nos buckets agregados
+#define READING_TEMP_SCALE     100.0f // centi-°C
+#define READING_HUMIDITY_SCALE 100.0f // centi-%
+#define READING_PRESSURE_SCALE 10.0f  // deci-hPa
+#define READING_PRESSURE_BASE  300.0f // hPa, origem do offset de pressão compactado
+#define READING_PRESSURE_BASE_PA 30000 // mesma origem em Pa (caminho inteiro)
 
 // Estrutura para armazenar uma leitura dos sensores
 typedef struct {
     float temperature;   // em °C
     float humidity;      // em %
     float pressure;      // em hPa
-    uint32_t timestamp;  // em segundos desde o boot
+    uint32_t timestamp;  // em segundos desde o boot (mais time_base)
 } SensorReading;
 
-// Estrutura para a pilha de leituras
+// Leitura compactada em ponto fixo: 8 bytes em vez de 16
+typedef struct {
+    int16_t temperature;  // centi-°C
+    uint16_t humidity;    // centi-%
+    uint16_t pressure;    // deci-hPa acima de READING_PRESSURE_BASE
+    uint16_t dt;          // segundos desde a base do bloco
+} PackedReading;
+
+// Amostras trocadas com o codec e com o log em flash usam CodecSample:
+// timestamp completo e valores nas mesmas unidades de PackedReading
+
+// Descritor de um bloco selado no arquivo comprimido
+typedef struct {
+    uint32_t first_ts;        // timestamp da primeira leitura do bloco
+    uint32_t last_ts;         // timestamp da última leitura do bloco
+    uint16_t offset;          // posição dos dados em archive[]
+    uint16_t nbytes;          // tamanho comprimido
+    uint16_t count;           // leituras no bloco
+} ArchiveBlock;
+
+// Agregado de um intervalo consultado no histórico
+typedef struct {
+    int count;
+    float min_temperature, max_temperature, mean_temperature;
+    float min_humidity, max_humidity, mean_humidity;
+    float min_pressure, max_pressure, mean_pressure;
+} ReadingAggregate;
+
+// Estatísticas de uma grandeza dentro de um bucket (em ponto fixo)
+typedef struct {
+    int16_t min;
+    int16_t max;
+    int16_t mean;
+} RollupField;
+
+// Bucket agregado de um intervalo (minuto ou hora): 24 bytes
+typedef struct {
+    uint32_t start;           // início do intervalo em segundos desde o boot
+    uint16_t count;           // número de amostras agregadas
+    RollupField temperature;  // centi-°C
+    RollupField humidity;     // centi-%
+    RollupField pressure;     // deci-hPa
+} RollupBucket;
+
+// Acumulador de uma grandeza no bucket aberto (inteiro, nas unidades de RollupBucket)
+typedef struct {
+    int32_t min;
+    int32_t max;
+    int32_t sum;
+} RollupAccum;
+
+// Nível de agregação
+typedef enum {
+    ROLLUP_MINUTE = 0,
+    ROLLUP_HOUR
+} RollupLevel;
+
+// Estado de um nível: anel de buckets fechados + bucket em aberto
+typedef struct {
+    int head;                 // Próxima posição a ser escrita no anel
+    int count;                // Buckets fechados armazenados
+    uint32_t period;          // Duração do bucket em segundos
+    uint32_t open_start;      // Início do bucket em aberto
+    uint32_t open_count;      // Amostras no bucket em aberto (0 = nenhum)
+    RollupAccum temperature;
+    RollupAccum humidity;
+    RollupAccum pressure;
+} RollupTier;
+
+// Buffer circular de leituras: head aponta para a próxima posição de escrita.
+// Ao entrar em um bloco, as leituras antigas restantes desse bloco são descartadas,
+// então a capacidade efetiva varia entre MAX_READINGS - READING_BLOCK_SIZE e MAX_READINGS
 typedef struct {
-    SensorReading readings[MAX_READINGS];  // Array de leituras
-    int count;                            // Número atual de leituras
+    PackedReading readings[MAX_READINGS];      // Array de leituras compactadas
+    uint32_t block_base[READING_BLOCK_COUNT];  // Timestamp base de cada bloco
+    CodecSample last_sample;                   // Última leitura em ponto fixo
+    SensorReading last;                        // Cópia em float, decodificada sob demanda
+    bool last_decoded;                         // last está em dia com last_sample
+    uint32_t time_base;                        // Somado aos segundos desde o boot (histórico contínuo entre resets)
+    int head;                                  // Próxima posição a ser escrita
+    int count;                                 // Número atual de leituras
+
+    // Arquivo de blocos selados e comprimidos (anel de bytes + anel de descritores)
+    uint8_t archive[READING_ARCHIVE_BYTES];
+    ArchiveBlock blocks[READING_ARCHIVE_BLOCKS];
+    int block_head;                            // Próximo descritor a ser escrito
+    int block_count;                           // Blocos no arquivo
+    uint32_t archive_write;                    // Próxima posição livre em archive[]
+    uint32_t archive_samples;                  // Leituras no arquivo
+
+    // Histórico agregado, atualizado incrementalmente a cada leitura
+    RollupBucket minutes[HISTORY_MINUTE_BUCKETS];
+    RollupBucket hours[HISTORY_HOUR_BUCKETS];
+    RollupTier minute_tier;
+    RollupTier hour_tier;
 } ReadingStore;
 
+// Iterador sobre as leituras, da mais antiga para a mais recente (decodifica sob demanda)
+typedef struct {
+    const ReadingStore* store;
+    int index;                            // Posição atual no array
+    int remaining;                        // Leituras que ainda faltam percorrer
+} ReadingIterator;
+
+// Cursor de consulta por intervalo de tempo sobre todo o histórico (arquivo + bloco aberto).
+// Decodifica um bloco por vez, sem descomprimir o arquivo inteiro
+typedef struct {
+    const ReadingStore* store;
+    uint32_t from;
+    uint32_t to;
+    int block;                            // Bloco arquivado atual (0 = mais antigo)
+    ReadingDecoder decoder;
+    int raw_index;                        // Posição no bloco aberto
+    int raw_remaining;                    // Leituras restantes do bloco aberto (-1 = ainda no arquivo)
+} ReadingCursor;
+
 // Inicializa o armazenamento de leituras
 void reading_store_init(ReadingStore* store);
 
-// Adiciona uma nova leitura (e remove a mais antiga se necessário)
+// Adiciona uma nova leitura em O(1) (sobrescreve a mais antiga se necessário)
 void reading_store_add(ReadingStore* store, float temp, float humidity, float pressure);
 
-// Obter todas as leituras armazenadas
-const SensorReading* reading_store_get_all(ReadingStore* store, int* count);
+// Adiciona uma leitura em ponto fixo (centi-°C, centi-%, Pa) sem passar por float
+void reading_store_add_fixed(ReadingStore* store, int32_t temperature, int32_t humidity, int32_t pressure);
 
-// Obter a última leitura
+// Adiciona uma leitura já codificada com timestamp próprio (ex.: reposição do log em flash)
+void reading_store_add_sample(ReadingStore* store, const CodecSample* sample);
+
+// Define o valor somado aos segundos desde o boot nos timestamps das novas leituras
+void reading_store_set_time_base(ReadingStore* store, uint32_t base);
+
+// Converte uma leitura para o formato de ponto fixo do armazenamento e vice-versa
+void reading_store_encode(const SensorReading* reading, CodecSample* out);
+void reading_store_decode(const CodecSample* sample, SensorReading* out);
+
+// Obter a i-ésima leitura (0 = mais antiga); retorna false se i estiver fora do intervalo
+bool reading_store_get_at(const ReadingStore* store, int i, SensorReading* out);
+
+// Obter a última leitura (convertida para float na primeira consulta após cada adição)
 const SensorReading* reading_store_get_last(ReadingStore* store);
 
+// Obter a última leitura em ponto fixo, sem conversão
+const CodecSample* reading_store_get_last_sample(const ReadingStore* store);
+
+// Número de leituras armazenadas
+int reading_store_count(const ReadingStore* store);
+
+// Inicia a iteração da mais antiga para a mais recente
+void reading_store_iter_begin(const ReadingStore* store, ReadingIterator* it);
+
+// Decodifica a próxima leitura em out; retorna false ao final
+bool reading_store_iter_next(ReadingIterator* it, SensorReading* out);
+
+// Inicia uma consulta pelas leituras com timestamp em [from, to]
+void reading_store_range_begin(const ReadingStore* store, ReadingCursor* cursor, uint32_t from, uint32_t to);
+
+// Decodifica a próxima leitura do intervalo em out; retorna false ao final
+bool reading_store_range_next(ReadingCursor* cursor, SensorReading* out);
+
+// Calcula min/máx/média das leituras em [from, to]; retorna false se não houver leituras
+bool reading_store_aggregate(const ReadingStore* store, uint32_t from, uint32_t to, ReadingAggregate* out);
+
+// Total de leituras no histórico (arquivo + bloco aberto)
+uint32_t reading_store_history_count(const ReadingStore* store);
+
+// Bytes ocupados pelos blocos comprimidos
+uint32_t reading_store_archive_bytes(const ReadingStore* store);
+
+// Número de buckets fechados no nível informado
+int reading_store_rollup_count(const ReadingStore* store, RollupLevel level);
+
+// Obter o i-ésimo bucket fechado do nível (0 = mais antigo)
+const RollupBucket* reading_store_rollup_get_at(const ReadingStore* store, RollupLevel level, int i);
+
+// Preenche out com o bucket ainda em aberto; retorna false se não houver amostras nele
+bool reading_store_rollup_current(const ReadingStore* store, RollupLevel level, RollupBucket* out);
+
 // Limpar todas as leituras
 void reading_store_clear(ReadingStore* store);
 
@@ -0,0 +1,54 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+// ============================================================================
+// UNIDADES DE PONTO FIXO DO PIPELINE DE MEDIÇÃO
+// ============================================================================
+// O RP2040 não tem FPU: do registrador do sensor até o armazenamento tudo é inteiro.
+// Conversão para float só acontece na borda (JSON/HTTP e mensagens de depuração raras).
+//   temperatura: centi-°C  (2534 = 25,34 °C)
+//   umidade:     centi-%   (5512 = 55,12 %)
+//   pressão:     Pa        (101325 = 1013,25 hPa)
+//   altitude:    cm
+
+static const int32_t fp_pow10[] = { 1, 10, 100, 1000, 10000, 100000 };
+
+/**
+ * Formata value / 10^frac_digits com 'decimals' casas (arredondando), sem ponto flutuante
+ */
+static inline char* fp_format(char* buf, size_t size, int32_t value, int frac_digits, int decimals) {
+    uint32_t mag = value < 0 ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+    int drop = frac_digits - decimals;
+    if (drop > 0) {
+        mag = (mag + fp_pow10[drop] / 2) / fp_pow10[drop];
+    }
+    const char* sign = (value < 0 && mag != 0) ? "-" : "";
+    unsigned long int_part = mag / fp_pow10[decimals];
+    unsigned long frac_part = mag % fp_pow10[decimals];
+    if (decimals > 0) {
+        snprintf(buf, size, "%s%lu.%0*lu", sign, int_part, decimals, frac_part);
+    } else {
+        snprintf(buf, size, "%s%lu", sign, int_part);
+    }
+    return buf;
+}
+
+/**
+ * Converte um valor de borda (JSON) para ponto fixo com arredondamento
+ */
+static inline int32_t fp_from_float(float value, int32_t scale) {
+    float scaled = value * (float)scale;
+    return (int32_t)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+/**
+ * Converte ponto fixo para float na borda (JSON)
+ */
+static inline float fp_to_float(int32_t value, int32_t scale) {
+    return (float)value / (float)scale;
+}
+
+#endif // FIXED_POINT_H
@@ -0,0 +1,91 @@
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Log de leituras somente-anexação em uma região reservada da flash.
+//  - A região é dividida em setores de 4 KB usados em rodízio (nivelamento de desgaste)
+//  - A página 0 de cada setor guarda apenas o cabeçalho com o número de sequência do setor
+//  - As páginas 1..15 guardam registros de 12 bytes com CRC-16 cada
+//  - Os registros são acumulados em RAM e gravados uma página por vez
+// Na inicialização só os cabeçalhos dos setores e algumas páginas são lidos para achar o fim do log
+
+#define FLASH_LOG_SECTOR_SIZE   4096u
+#define FLASH_LOG_PAGE_SIZE     256u
+#define FLASH_LOG_RECORD_SIZE   12u
+#define FLASH_LOG_PAGES_PER_SECTOR (FLASH_LOG_SECTOR_SIZE / FLASH_LOG_PAGE_SIZE)
+#define FLASH_LOG_RECORDS_PER_PAGE (FLASH_LOG_PAGE_SIZE / FLASH_LOG_RECORD_SIZE)
+
+// Tamanho e posição da região (offset a partir do início da flash)
+#ifndef FLASH_LOG_SIZE
+#define FLASH_LOG_SIZE (256u * 1024u)
+#endif
+#ifndef FLASH_LOG_OFFSET
+#define FLASH_LOG_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_LOG_SIZE)
+#endif
+
+// Registro gravado na flash (mesmas unidades de CodecSample)
+typedef struct {
+    uint32_t timestamp;
+    int16_t temperature;   // centi-°C
+    uint16_t humidity;     // centi-%
+    uint16_t pressure;     // deci-hPa acima de READING_PRESSURE_BASE
+    uint16_t crc;          // CRC-16/CCITT dos 10 bytes anteriores
+} FlashLogRecord;
+
+// Operações de armazenamento; offsets são relativos ao início da região do log
+typedef struct {
+    bool (*read)(void* ctx, uint32_t offset, void* dst, size_t len);
+    bool (*erase_sector)(void* ctx, uint32_t offset);
+    bool (*program_page)(void* ctx, uint32_t offset, const uint8_t* page);
+    void* ctx;
+} FlashLogIO;
+
+typedef struct {
+    FlashLogIO io;
+    uint32_t sector_count;
+    uint32_t head_sector;        // Setor sendo preenchido
+    uint32_t head_page;          // Próxima página livre no setor (FLASH_LOG_PAGES_PER_SECTOR = cheio)
+    uint32_t sequence;           // Sequência do setor atual (0 = log vazio; dá a volta pulando o 0)
+    uint32_t last_timestamp;     // Timestamp do último registro anexado
+    uint8_t page[FLASH_LOG_PAGE_SIZE];
+    int page_fill;               // Registros no buffer de página
+    uint32_t erase_count;        // Estatísticas desde o boot
+    uint32_t program_count;
+} FlashLog;
+
+// Iterador do registro mais antigo para o mais recente (inclui o buffer ainda não gravado)
+typedef struct {
+    const FlashLog* log;
+    uint32_t sectors_left;
+    uint32_t sector;
+    uint32_t page;
+    int slot;
+    bool in_buffer;
+} FlashLogIter;
+
+// Recupera o estado do log a partir da flash; retorna false se a região for inválida
+bool flash_log_init(FlashLog* log, const FlashLogIO* io, uint32_t size);
+
+// Anexa um registro (o CRC é calculado aqui); grava a página quando ela enche
+bool flash_log_append(FlashLog* log, uint32_t timestamp, int16_t temperature,
+                      uint16_t humidity, uint16_t pressure);
+
+// Grava a página parcial; os próximos registros vão para a página seguinte
+bool flash_log_flush(FlashLog* log);
+
+// Percorre os registros válidos do mais antigo para o mais recente
+void flash_log_iter_begin(const FlashLog* log, FlashLogIter* it);
+bool flash_log_iter_next(FlashLogIter* it, FlashLogRecord* out);
+
+#ifdef FLASH_LOG_HOST
+// Backend para testes no host: a região é um arquivo (criado apagado se não existir)
+bool flash_log_file_io(FlashLogIO* io, const char* path, uint32_t size);
+#else
+// Backend da Pico: leitura via XIP, apagamento/gravação com flash_safe_execute
+void flash_log_pico_io(FlashLogIO* io);
+#endif
+
+#endif // FLASH_LOG_H
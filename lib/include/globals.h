@@ -12,7 +12,6 @@
 #define I2C_PORT i2c0               // i2c0 pinos 0 e 1, i2c1 pinos 2 e 3
 #define I2C_SDA 0                   // 0 ou 2
 #define I2C_SCL 1                   // 1 ou 3
-#define SEA_LEVEL_PRESSURE 101325.0 // Pressão ao nível do mar em Pa
 // Display na I2C1
 #define I2C_PORT_DISP i2c1   	// Define que o barramento I2C usado será o "i2c0"
 #define I2C_SDA_DISP 14      	// Define que o pino GPIO 14 será usado como SDA (linha de dados do I2C)
@@ -0,0 +1,114 @@
+#ifndef HTTP_CONN_H
+#define HTTP_CONN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "lwip/tcp.h"
+
+// Pool estático de conexões HTTP.
+//  - HTTP_MAX_CONNECTIONS slots reservados em tempo de compilação (sem malloc por requisição)
+//  - Pilha de índices livres: obter e devolver um slot é O(1)
+//  - Um slot acompanha a conexão inteira (HTTP/1.1 persistente): guarda os bytes de
+//    requisição recebidos e a resposta em andamento
+//  - Pool cheio: a conexão ociosa mais antiga é fechada para dar lugar à nova; sem
+//    nenhuma ociosa, a requisição recebe 503 sem ocupar slot (ver connection_callback)
+// Usado só pela thread tcpip do lwIP; as estatísticas podem ser lidas de outra tarefa
+// (palavras de 32 bits, sem rasgo)
+//
+// Uma resposta é uma sequência de partes. Partes montadas no slot (JSON) são copiadas
+// pelo lwIP; partes estáticas (cabeçalho pré-montado, página em flash) vão por
+// referência, sem cópia e sem limite de tamanho: o slot só guarda a posição do envio.
+
+// Número de conexões atendidas ao mesmo tempo
+#ifndef HTTP_MAX_CONNECTIONS
+#define HTTP_MAX_CONNECTIONS 4
+#endif
+
+// Conexão sem tráfego por este tempo é fechada (keep-alive ocioso ou requisição parada)
+#ifndef HTTP_IDLE_TIMEOUT_S
+#define HTTP_IDLE_TIMEOUT_S 5
+#endif
+
+// Tamanho máximo de uma resposta montada no slot (JSON); conteúdo estático não ocupa o slot
+#define HTTP_RESPONSE_SIZE 1536
+
+// Bytes de requisição guardados por conexão (cabeçalhos + corpo, pipelining incluído)
+#define HTTP_REQUEST_SIZE 1024
+
+// Partes por resposta (cabeçalho + Connection + corpo)
+#define HTTP_MAX_PARTS 3
+
+typedef struct {
+    const char* data;
+    size_t len;
+    bool copy;                  // true = buffer do slot (lwIP copia); false = estático, por referência
+} HttpPart;
+
+typedef struct http_state {
+    char request[HTTP_REQUEST_SIZE + 1];    // +1: a requisição atendida termina em '\0'
+    size_t request_len;         // Bytes recebidos ainda não atendidos
+    char response[HTTP_RESPONSE_SIZE];
+    size_t len;                 // Bytes montados em response
+    HttpPart parts[HTTP_MAX_PARTS];
+    uint8_t part_count;
+    uint8_t part;               // Parte sendo entregue ao lwIP
+    size_t part_offset;         // Bytes da parte atual já entregues
+    size_t total;               // Tamanho da resposta (todas as partes)
+    size_t sent;                // Bytes confirmados pelo cliente
+    bool static_asset;          // Resposta de conteúdo estático (medida à parte)
+    bool keep_alive;            // Mantém a conexão aberta depois desta resposta
+    uint64_t start_us;          // Chegada da requisição (medição de latência)
+    uint64_t last_active_us;    // Último tráfego (escolha da conexão ociosa a fechar)
+    uint8_t idle_polls;         // Segundos sem tráfego (tcp_poll)
+    bool in_use;
+    uint8_t slot;               // Índice no pool
+    struct tcp_pcb* pcb;
+} HttpConn;
+
+typedef struct {
+    uint32_t in_use;            // Slots ocupados agora
+    uint32_t high_water;        // Maior ocupação desde o boot
+    uint32_t acquired;          // Conexões atendidas
+    uint32_t rejected;          // Conexões recusadas com pool cheio (503)
+    uint32_t evicted;           // Conexões ociosas fechadas para liberar slot
+} HttpConnStats;
+
+// Inicializa o pool com todos os slots livres
+void http_conn_pool_init(void);
+
+// Obtém um slot livre para a conexão (NULL se o pool estiver cheio)
+HttpConn* http_conn_acquire(struct tcp_pcb* pcb);
+
+// Devolve o slot ao pool
+void http_conn_release(HttpConn* conn);
+
+// Escolhe a conexão ociosa (sem requisição nem resposta pendente) há mais tempo, para ser
+// fechada pelo chamador; conta em evicted. NULL se todas estiverem ocupadas
+HttpConn* http_conn_oldest_idle(void);
+
+// Conta uma conexão sem slot respondida com 503 (pool cheio e nenhuma ociosa para fechar).
+// Tentativas de acquire que terminam em despejo de uma ociosa não contam
+void http_conn_note_rejected(void);
+
+// Estatísticas de ocupação do pool
+const HttpConnStats* http_conn_stats(void);
+
+// Descarta a resposta concluída; a conexão fica pronta para a próxima requisição
+void http_conn_reset_response(HttpConn* conn);
+
+// Há resposta montada ainda não confirmada pelo cliente?
+static inline bool http_conn_busy(const HttpConn* conn) {
+    return conn->part_count > 0;
+}
+
+// Acrescenta uma parte à resposta (copy = false exige memória estática)
+void http_conn_add_part(HttpConn* conn, const char* data, size_t len, bool copy);
+
+// Entrega ao lwIP o máximo que couber no buffer de envio; o restante sai em http_conn_acked
+err_t http_conn_pump(HttpConn* conn, struct tcp_pcb* pcb);
+
+// Contabiliza bytes confirmados; retorna true quando a resposta inteira foi confirmada
+bool http_conn_acked(HttpConn* conn, u16_t len);
+
+#endif // HTTP_CONN_H
@@ -0,0 +1,46 @@
+#ifndef HTTP_REQUEST_H
+#define HTTP_REQUEST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Leitura de cabeçalhos de uma requisição HTTP/1.1 já recebida.
+// As funções recebem o tamanho dos dados: o buffer não precisa terminar em '\0'
+
+/**
+ * Tamanho da primeira requisição em buf: cabeçalhos até a linha em branco mais o corpo
+ * indicado em Content-Length. Retorna 0 enquanto os cabeçalhos não chegaram inteiros;
+ * o valor pode passar de len (corpo ainda chegando)
+ */
+size_t http_request_length(const char* buf, size_t len);
+
+/**
+ * A conexão continua aberta depois da resposta? HTTP/1.1 sim, salvo "Connection: close";
+ * HTTP/1.0 só com "Connection: keep-alive"
+ */
+bool http_keep_alive(const char* req, size_t len);
+
+/**
+ * Procura o cabeçalho 'name' (sem diferenciar maiúsculas) antes da linha em branco.
+ * Retorna o início do valor, sem espaços nas pontas, e seu tamanho em value_len; NULL se não existir
+ */
+const char* http_find_header(const char* req, size_t len, const char* name, size_t* value_len);
+
+/**
+ * Verifica se uma lista separada por vírgulas (ex.: Accept-Encoding) aceita 'token'.
+ * Aceita também '*'; parâmetros q=0 recusam a opção
+ */
+bool http_list_accepts(const char* value, size_t value_len, const char* token);
+
+/**
+ * Atalho: a requisição aceita Content-Encoding: gzip?
+ */
+bool http_accepts_gzip(const char* req, size_t len);
+
+/**
+ * O If-None-Match da requisição casa com 'etag' (com aspas, ex.: "\"abc\"" ou "W/\"abc\"")?
+ * Usa a comparação fraca da RFC 9110 (ignora W/) e aceita '*'. Sem o cabeçalho, false
+ */
+bool http_etag_matches(const char* req, size_t len, const char* etag);
+
+#endif // HTTP_REQUEST_H
@@ -15,7 +15,8 @@ const char HTML_BODY[] =
 "<div class=\"card\"><h2>📊 Leituras dos Sensores</h2><div class=\"sensor-values\">"
 "<div class=\"sensor-item\" id=\"temp-item\"><div>🌡️ <strong>Temperatura</strong></div><div><span id=\"temp\">--</span>°C</div></div>"
 "<div class=\"sensor-item\" id=\"humidity-item\"><div>💧 <strong>Umidade</strong></div><div><span id=\"humidity\">--</span>%</div></div>"
-"<div class=\"sensor-item\" id=\"pressure-item\"><div>📈 <strong>Pressão</strong></div><div><span id=\"pressure\">--</span> hPa</div></div></div></div>"
+"<div class=\"sensor-item\" id=\"pressure-item\"><div>📈 <strong>Pressão</strong></div><div><span id=\"pressure\">--</span> hPa</div></div>"
+"<div class=\"sensor-item\" id=\"altitude-item\"><div>⛰️ <strong>Altitude</strong></div><div><span id=\"altitude\">--</span> m</div></div></div></div>"
 
 "<div class=\"card\"><h2>📉 Histórico de Leituras</h2><canvas id=\"sensorChart\" height=\"200\"></canvas></div>"
 
@@ -26,6 +27,9 @@ const char HTML_BODY[] =
 "<div class=\"form-group\"><label for=\"max_hum\">💧 Umidade Máxima (%):</label><input type=\"number\" id=\"max_hum\" name=\"max_hum\" step=\"0.1\" min=\"0\" max=\"100\" required></div>"
 "<div class=\"form-group\"><label for=\"min_press\">📈 Pressão Mínima (hPa):</label><input type=\"number\" id=\"min_press\" name=\"min_press\" step=\"0.1\" required></div>"
 "<div class=\"form-group\"><label for=\"max_press\">📈 Pressão Máxima (hPa):</label><input type=\"number\" id=\"max_press\" name=\"max_press\" step=\"0.1\" required></div>"
+"<div class=\"form-group\"><label for=\"min_alt\">⛰️ Altitude Mínima (m):</label><input type=\"number\" id=\"min_alt\" name=\"min_alt\" step=\"0.1\" required></div>"
+"<div class=\"form-group\"><label for=\"max_alt\">⛰️ Altitude Máxima (m):</label><input type=\"number\" id=\"max_alt\" name=\"max_alt\" step=\"0.1\" required></div>"
+"<div class=\"form-group\"><label for=\"qnh\">🌊 Pressão ao Nível do Mar - QNH (hPa):</label><input type=\"number\" id=\"qnh\" name=\"qnh\" step=\"0.01\" min=\"870\" max=\"1085\" required></div>"
 "<div class=\"button-group\"><button type=\"submit\">💾 Salvar Limites</button><button type=\"button\" id=\"reset-btn\">🔄 Resetar Padrão</button><button type=\"button\" id=\"toggle-alerts\">🔔 Alternar Alertas</button></div></form></div>"
 
 "<script>let alertsEnabled=true,tempHist=[],humHist=[],pressHist=[],labels=[];"
@@ -35,29 +39,36 @@ const char HTML_BODY[] =
 "{label:'Umidade (%)',data:humHist,borderColor:'blue',fill:false},"
 "{label:'Pressão (hPa)',data:pressHist,borderColor:'green',fill:false}]},options:{responsive:true,scales:{y:{beginAtZero:false}}}});"
 
-"async function fetchData(){try{const[tempRes,humRes,presRes,limRes,statusRes]=await Promise.all([fetch(\"/temperature\"),fetch(\"/humidity\"),fetch(\"/atm_pressure\"),fetch(\"/limits\"),fetch(\"/sensor_status\")]);"
-"if(!tempRes.ok||!humRes.ok||!presRes.ok)throw new Error(\"Erro ao buscar dados dos sensores\");"
-"const temp=await tempRes.json(),hum=await humRes.json(),pres=await presRes.json(),limits=await limRes.json(),status=await statusRes.json();"
-"document.getElementById(\"temp\").textContent=temp.value?temp.value.toFixed(1):\"--\";"
-"document.getElementById(\"humidity\").textContent=hum.value?hum.value.toFixed(1):\"--\";"
-"document.getElementById(\"pressure\").textContent=pres.value?pres.value.toFixed(1):\"--\";"
-"if(temp.timestamp){labels.push(new Date(temp.timestamp).toLocaleTimeString());if(labels.length>10){labels.shift();tempHist.shift();humHist.shift();pressHist.shift()}"
-"tempHist.push(temp.value);humHist.push(hum.value);pressHist.push(pres.value);chart.update();}"
-"document.getElementById(\"min_temp\").value=limits.min_temp||\"\";"
-"document.getElementById(\"max_temp\").value=limits.max_temp||\"\";"
-"document.getElementById(\"min_hum\").value=limits.min_hum||\"\";"
-"document.getElementById(\"max_hum\").value=limits.max_hum||\"\";"
-"document.getElementById(\"min_press\").value=limits.min_press||\"\";"
-"document.getElementById(\"max_press\").value=limits.max_press||\"\";"
-"alertsEnabled=limits.alert_enabled!==false;"
-"const statusBar=document.getElementById(\"status-bar\"),tempItem=document.getElementById(\"temp-item\"),humItem=document.getElementById(\"humidity-item\"),presItem=document.getElementById(\"pressure-item\");"
-"tempItem.classList.toggle(\"alert\",!status.temperature.ok);humItem.classList.toggle(\"alert\",!status.humidity.ok);presItem.classList.toggle(\"alert\",!status.pressure.ok);"
-"if(status.all_ok){statusBar.className=\"status ok\";statusBar.textContent=\"✅ Todos os sensores funcionando normalmente\"}else{statusBar.className=\"status alert\";statusBar.textContent=\"⚠️ \"+status.alert_message}}"
+"let lastSeq=-1;"
+"async function fetchData(){try{const res=await fetch(\"/api/snapshot\");"
+"if(!res.ok)throw new Error(\"Erro ao buscar dados dos sensores\");"
+"const snap=await res.json(),r=snap.reading,limits=snap.limits,status=snap.status;"
+"if(r){document.getElementById(\"temp\").textContent=r.temperature.toFixed(1);"
+"document.getElementById(\"humidity\").textContent=r.humidity.toFixed(1);"
+"document.getElementById(\"pressure\").textContent=r.pressure.toFixed(1);"
+"document.getElementById(\"altitude\").textContent=r.altitude.toFixed(1);"
+"if(snap.seq!==lastSeq){lastSeq=snap.seq;labels.push(new Date().toLocaleTimeString());if(labels.length>10){labels.shift();tempHist.shift();humHist.shift();pressHist.shift()}"
+"tempHist.push(r.temperature);humHist.push(r.humidity);pressHist.push(r.pressure);chart.update();}}"
+"document.getElementById(\"min_temp\").value=limits.min_temp;"
+"document.getElementById(\"max_temp\").value=limits.max_temp;"
+"document.getElementById(\"min_hum\").value=limits.min_hum;"
+"document.getElementById(\"max_hum\").value=limits.max_hum;"
+"document.getElementById(\"min_press\").value=limits.min_press;"
+"document.getElementById(\"max_press\").value=limits.max_press;"
+"document.getElementById(\"min_alt\").value=limits.min_alt;"
+"document.getElementById(\"max_alt\").value=limits.max_alt;"
+"document.getElementById(\"qnh\").value=limits.qnh;"
+"alertsEnabled=snap.alert.enabled;"
+"const statusBar=document.getElementById(\"status-bar\"),tempItem=document.getElementById(\"temp-item\"),humItem=document.getElementById(\"humidity-item\"),presItem=document.getElementById(\"pressure-item\"),altItem=document.getElementById(\"altitude-item\");"
+"if(!status){statusBar.className=\"status ok\";statusBar.textContent=\"Aguardando a primeira leitura...\";return}"
+"tempItem.classList.toggle(\"alert\",!status.temperature);humItem.classList.toggle(\"alert\",!status.humidity);presItem.classList.toggle(\"alert\",!status.pressure);altItem.classList.toggle(\"alert\",!status.altitude);"
+"if(status.all_ok){statusBar.className=\"status ok\";statusBar.textContent=\"✅ Todos os sensores funcionando normalmente\"}else{statusBar.className=\"status alert\";statusBar.textContent=\"⚠️ \"+snap.alert.message}}"
 "catch(err){const s=document.getElementById(\"status-bar\");s.className=\"status alert\";s.textContent=\"❌ Erro de conexão: \"+err.message}}"
 "document.getElementById(\"config-form\").addEventListener(\"submit\",async e=>{e.preventDefault();try{"
 "const formData={min_temp:parseFloat(document.getElementById(\"min_temp\").value),max_temp:parseFloat(document.getElementById(\"max_temp\").value),"
 "min_hum:parseFloat(document.getElementById(\"min_hum\").value),max_hum:parseFloat(document.getElementById(\"max_hum\").value),"
-"min_press:parseFloat(document.getElementById(\"min_press\").value),max_press:parseFloat(document.getElementById(\"max_press\").value)};"
+"min_press:parseFloat(document.getElementById(\"min_press\").value),max_press:parseFloat(document.getElementById(\"max_press\").value),"
+"min_alt:parseFloat(document.getElementById(\"min_alt\").value),max_alt:parseFloat(document.getElementById(\"max_alt\").value),qnh:parseFloat(document.getElementById(\"qnh\").value)};"
 "const res=await fetch(\"/limits\",{method:\"POST\",headers:{\"Content-Type\":\"application/json\"},body:JSON.stringify(formData)}),result=await res.json();"
 "if(result.status===\"success\")alert(\"✅ Limites atualizados com sucesso!\");else alert(\"❌ Erro: \"+result.message)}catch(err){alert(\"❌ Erro de conexão ao salvar limites\")}});"
 "document.getElementById(\"reset-btn\").addEventListener(\"click\",async()=>{if(confirm(\"Deseja resetar todos os limites aos valores padrão?\"))try{"
@@ -0,0 +1,60 @@
+#ifndef READING_CODEC_H
+#define READING_CODEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Codificação de um bloco de leituras compactadas em fluxo de bits:
+//  - timestamps: primeiro valor em 32 bits, depois delta-of-delta
+//  - temperatura/umidade/pressão: primeiro valor em 16 bits, depois delta do valor anterior
+// Cada delta é codificado em zigzag com prefixo de tamanho variável:
+//   '0' = 0 | '10' + 4 bits | '110' + 8 bits | '1110' + 16 bits | '1111' + 32 bits
+// Sinais meteorológicos variam pouco, então a maioria das amostras ocupa poucos bits
+
+// Pior caso em bytes para um bloco de n leituras
+#define READING_CODEC_MAX_BYTES(n) (10 + (size_t)(n) * 18)
+
+// Valores inteiros de uma amostra (mesmas unidades de PackedReading)
+typedef struct {
+    uint32_t timestamp;
+    int16_t temperature;
+    uint16_t humidity;
+    uint16_t pressure;
+} CodecSample;
+
+// Estado de decodificação incremental de um bloco
+typedef struct {
+    const uint8_t* data;
+    uint32_t bitpos;
+    int remaining;
+    uint32_t delta;         // último delta de timestamp (módulo 2^32)
+    CodecSample prev;       // amostra decodificada anterior
+} ReadingDecoder;
+
+// Estado de codificação incremental de um bloco
+typedef struct {
+    uint8_t* data;
+    size_t capacity;
+    uint32_t bitpos;
+    int count;
+    uint32_t delta;         // último delta de timestamp (módulo 2^32)
+    CodecSample prev;
+} ReadingEncoder;
+
+// Inicia a codificação em um buffer com capacidade em bytes
+void reading_encoder_init(ReadingEncoder* enc, uint8_t* data, size_t capacity);
+
+// Acrescenta uma amostra; retorna false se o buffer não tiver espaço
+bool reading_encoder_add(ReadingEncoder* enc, const CodecSample* sample);
+
+// Número de bytes usados até agora
+size_t reading_encoder_bytes(const ReadingEncoder* enc);
+
+// Inicia a decodificação de um bloco de count amostras
+void reading_decoder_init(ReadingDecoder* dec, const uint8_t* data, int count);
+
+// Decodifica a próxima amostra; retorna false ao final do bloco
+bool reading_decoder_next(ReadingDecoder* dec, CodecSample* out);
+
+#endif // READING_CODEC_H
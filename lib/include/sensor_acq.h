@@ -0,0 +1,55 @@
+#ifndef SENSOR_ACQ_H
+#define SENSOR_ACQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "aht20.h"
+#include "bmp280.h"
+
+// Máquina de estados da aquisição em duas fases no barramento dos sensores:
+//   sensor_acq_trigger() dispara a conversão do AHT20 e retorna imediatamente;
+//   sensor_acq_poll() só usa o barramento depois do tempo de conversão e então coleta
+//   o AHT20 (status + dados em uma leitura) e o resultado mais recente do BMP280,
+//   que converte continuamente em modo normal, em paralelo ao AHT20.
+// Disparando ao fim de um ciclo e coletando no início do seguinte, a conversão
+// acontece durante o intervalo entre amostras e o loop não espera pelos sensores.
+
+typedef enum {
+    SENSOR_ACQ_IDLE = 0,        // Nenhuma conversão em andamento
+    SENSOR_ACQ_CONVERTING,      // AHT20 convertendo; aguardando ready_at
+    SENSOR_ACQ_READY            // Resultado disponível em raw_temp/raw_pressure/aht
+} SensorAcqState;
+
+typedef struct {
+    i2c_inst_t *i2c;
+    SensorAcqState state;
+    absolute_time_t ready_at;   // Momento a partir do qual vale a pena consultar o AHT20
+    uint8_t busy_retries;       // Consultas que encontraram o AHT20 ocupado
+
+    // Resultado da última coleta
+    int32_t raw_temp;           // BMP280
+    int32_t raw_pressure;       // BMP280
+    AHT20_Data aht;
+    bool aht_ok;
+
+    // Medição: tempo em que o loop ficou ocupado com os sensores (coleta + disparo)
+    uint32_t busy_us;           // Acumulado do ciclo em andamento
+    uint32_t cycle_us;          // Último ciclo completo
+    uint32_t cycle_us_max;
+} SensorAcq;
+
+// Inicializa a máquina de estados para o barramento informado
+void sensor_acq_init(SensorAcq *acq, i2c_inst_t *i2c);
+
+// Dispara uma nova conversão (não bloqueia)
+void sensor_acq_trigger(SensorAcq *acq);
+
+// Avança a máquina de estados sem bloquear; retorna true quando há resultado pronto
+bool sensor_acq_poll(SensorAcq *acq);
+
+// Consome o resultado pronto e volta para IDLE
+void sensor_acq_consume(SensorAcq *acq);
+
+#endif // SENSOR_ACQ_H
@@ -6,24 +6,36 @@
 #define SENSOR_LIMITS_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "flash_log.h"
+#include "fixed_point.h"
+#include "altitude.h"
 
-// Estrutura para armazenar os limites de cada sensor
+// Estrutura para armazenar os limites de cada sensor (ponto fixo, ver fixed_point.h)
 typedef struct {
-    // Limites de temperatura (°C)
-    float min_temp;
-    float max_temp;
+    // Limites de temperatura (centi-°C)
+    int32_t min_temp;
+    int32_t max_temp;
     
-    // Limites de umidade (%)
-    float min_humidity;
-    float max_humidity;
+    // Limites de umidade (centi-%)
+    int32_t min_humidity;
+    int32_t max_humidity;
     
-    // Limites de pressão atmosférica (hPa)
-    float min_pressure;
-    float max_pressure;
+    // Limites de pressão atmosférica (Pa)
+    int32_t min_pressure;
+    int32_t max_pressure;
     
-    // Limites de altitude (metros) - calculada a partir da pressão
-    float min_altitude;
-    float max_altitude;
+    // Limites de altitude (cm) - calculada a partir da pressão
+    int32_t min_altitude;
+    int32_t max_altitude;
+
+    // Pressão ao nível do mar de referência (QNH, Pa) usada no cálculo da altitude
+    int32_t sea_level_pressure;
     
     // Flags para indicar se os limites foram configurados
     bool limits_configured;
@@ -42,68 +54,108 @@ extern SensorLimits sensor_limits;
  */
 void sensor_limits_init(SensorLimits* limits) {
     // Limites padrão baseados em condições normais
-    limits->min_temp = 15.0f;        // 15°C mínimo
-    limits->max_temp = 35.0f;        // 35°C máximo
+    limits->min_temp = 1500;         // 15°C mínimo
+    limits->max_temp = 3500;         // 35°C máximo
     
-    limits->min_humidity = 30.0f;    // 30% umidade mínima
-    limits->max_humidity = 80.0f;    // 80% umidade máxima
+    limits->min_humidity = 3000;     // 30% umidade mínima
+    limits->max_humidity = 8000;     // 80% umidade máxima
     
-    limits->min_pressure = 980.0f;   // 980 hPa pressão mínima
-    limits->max_pressure = 1030.0f;  // 1030 hPa pressão máxima
+    limits->min_pressure = 98000;    // 980 hPa pressão mínima
+    limits->max_pressure = 103000;   // 1030 hPa pressão máxima
     
-    limits->min_altitude = -100.0f;  // -100m altitude mínima
-    limits->max_altitude = 1000.0f;  // 1000m altitude máxima
+    limits->min_altitude = -10000;   // -100m altitude mínima
+    limits->max_altitude = 100000;   // 1000m altitude máxima
+
+    limits->sea_level_pressure = ALTITUDE_STANDARD_QNH;
     
     limits->limits_configured = true;
     limits->alert_enabled = true;
 }
 
 /**
- * Define novos limites de temperatura
+ * Define novos limites de temperatura (centi-°C)
  */
-void sensor_limits_set_temperature(SensorLimits* limits, float min_temp, float max_temp) {
+void sensor_limits_set_temperature(SensorLimits* limits, int32_t min_temp, int32_t max_temp) {
+    char min_str[12], max_str[12];
     if (min_temp < max_temp) {
         limits->min_temp = min_temp;
         limits->max_temp = max_temp;
-        printf("Limites de temperatura atualizados: %.1f°C - %.1f°C\n", min_temp, max_temp);
+        printf("Limites de temperatura atualizados: %s°C - %s°C\n",
+               fp_format(min_str, sizeof(min_str), min_temp, 2, 1),
+               fp_format(max_str, sizeof(max_str), max_temp, 2, 1));
     } else {
         printf("ERRO: Temperatura mínima deve ser menor que máxima!\n");
     }
 }
 
 /**
- * Define novos limites de umidade
+ * Define novos limites de umidade (centi-%)
  */
-void sensor_limits_set_humidity(SensorLimits* limits, float min_hum, float max_hum) {
-    if (min_hum >= 0 && max_hum <= 100 && min_hum < max_hum) {
+void sensor_limits_set_humidity(SensorLimits* limits, int32_t min_hum, int32_t max_hum) {
+    char min_str[12], max_str[12];
+    if (min_hum >= 0 && max_hum <= 10000 && min_hum < max_hum) {
         limits->min_humidity = min_hum;
         limits->max_humidity = max_hum;
-        printf("Limites de umidade atualizados: %.1f%% - %.1f%%\n", min_hum, max_hum);
+        printf("Limites de umidade atualizados: %s%% - %s%%\n",
+               fp_format(min_str, sizeof(min_str), min_hum, 2, 1),
+               fp_format(max_str, sizeof(max_str), max_hum, 2, 1));
     } else {
         printf("ERRO: Limites de umidade inválidos (0-100%% e min < max)!\n");
     }
 }
 
 /**
- * Define novos limites de pressão
+ * Define novos limites de pressão (Pa)
  */
-void sensor_limits_set_pressure(SensorLimits* limits, float min_press, float max_press) {
+void sensor_limits_set_pressure(SensorLimits* limits, int32_t min_press, int32_t max_press) {
+    char min_str[12], max_str[12];
     if (min_press > 0 && max_press > 0 && min_press < max_press) {
         limits->min_pressure = min_press;
         limits->max_pressure = max_press;
-        printf("Limites de pressão atualizados: %.1f hPa - %.1f hPa\n", min_press, max_press);
+        printf("Limites de pressão atualizados: %s hPa - %s hPa\n",
+               fp_format(min_str, sizeof(min_str), min_press, 2, 1),
+               fp_format(max_str, sizeof(max_str), max_press, 2, 1));
     } else {
         printf("ERRO: Limites de pressão inválidos!\n");
     }
 }
 
+/**
+ * Define novos limites de altitude (cm)
+ */
+void sensor_limits_set_altitude(SensorLimits* limits, int32_t min_alt, int32_t max_alt) {
+    char min_str[12], max_str[12];
+    if (min_alt < max_alt) {
+        limits->min_altitude = min_alt;
+        limits->max_altitude = max_alt;
+        printf("Limites de altitude atualizados: %s m - %s m\n",
+               fp_format(min_str, sizeof(min_str), min_alt, 2, 1),
+               fp_format(max_str, sizeof(max_str), max_alt, 2, 1));
+    } else {
+        printf("ERRO: Altitude mínima deve ser menor que máxima!\n");
+    }
+}
+
+/**
+ * Define a pressão ao nível do mar de referência (QNH, Pa)
+ */
+void sensor_limits_set_qnh(SensorLimits* limits, int32_t qnh) {
+    char qnh_str[12];
+    if (qnh >= ALTITUDE_QNH_MIN && qnh <= ALTITUDE_QNH_MAX) {
+        limits->sea_level_pressure = qnh;
+        printf("QNH atualizado: %s hPa\n", fp_format(qnh_str, sizeof(qnh_str), qnh, 2, 2));
+    } else {
+        printf("ERRO: QNH fora da faixa (%d-%d Pa)!\n", ALTITUDE_QNH_MIN, ALTITUDE_QNH_MAX);
+    }
+}
+
 /**
  * Define todos os limites de uma vez
  */
 void sensor_limits_set_all(SensorLimits* limits, 
-                          float min_temp, float max_temp,
-                          float min_hum, float max_hum,
-                          float min_press, float max_press) {
+                          int32_t min_temp, int32_t max_temp,
+                          int32_t min_hum, int32_t max_hum,
+                          int32_t min_press, int32_t max_press) {
     sensor_limits_set_temperature(limits, min_temp, max_temp);
     sensor_limits_set_humidity(limits, min_hum, max_hum);
     sensor_limits_set_pressure(limits, min_press, max_press);
@@ -117,29 +169,37 @@ void sensor_limits_set_all(SensorLimits* limits,
 // ============================================================================
 
 /**
- * Verifica se a temperatura está dentro dos limites
+ * Verifica se a temperatura (centi-°C) está dentro dos limites
  */
-bool sensor_limits_check_temperature(const SensorLimits* limits, float temperature) {
+bool sensor_limits_check_temperature(const SensorLimits* limits, int32_t temperature) {
     if (!limits->alert_enabled) return true;
     return (temperature >= limits->min_temp && temperature <= limits->max_temp);
 }
 
 /**
- * Verifica se a umidade está dentro dos limites
+ * Verifica se a umidade (centi-%) está dentro dos limites
  */
-bool sensor_limits_check_humidity(const SensorLimits* limits, float humidity) {
+bool sensor_limits_check_humidity(const SensorLimits* limits, int32_t humidity) {
     if (!limits->alert_enabled) return true;
     return (humidity >= limits->min_humidity && humidity <= limits->max_humidity);
 }
 
 /**
- * Verifica se a pressão está dentro dos limites
+ * Verifica se a pressão (Pa) está dentro dos limites
  */
-bool sensor_limits_check_pressure(const SensorLimits* limits, float pressure) {
+bool sensor_limits_check_pressure(const SensorLimits* limits, int32_t pressure) {
     if (!limits->alert_enabled) return true;
     return (pressure >= limits->min_pressure && pressure <= limits->max_pressure);
 }
 
+/**
+ * Verifica se a altitude (cm) está dentro dos limites
+ */
+bool sensor_limits_check_altitude(const SensorLimits* limits, int32_t altitude) {
+    if (!limits->alert_enabled) return true;
+    return (altitude >= limits->min_altitude && altitude <= limits->max_altitude);
+}
+
 /**
  * Estrutura para resultado da verificação de limites
  */
@@ -147,31 +207,38 @@ typedef struct {
     bool temperature_ok;
     bool humidity_ok;
     bool pressure_ok;
+    bool altitude_ok;
     bool all_ok;
     char alert_message[256];
 } LimitCheckResult;
 
 /**
  * Verifica todos os sensores e retorna resultado detalhado
+ * (temperatura em centi-°C, umidade em centi-%, pressão em Pa, altitude em cm)
  */
 LimitCheckResult sensor_limits_check_all(const SensorLimits* limits, 
-                                        float temperature, 
-                                        float humidity, 
-                                        float pressure) {
+                                        int32_t temperature, 
+                                        int32_t humidity, 
+                                        int32_t pressure,
+                                        int32_t altitude) {
     LimitCheckResult result = {0};
     char temp_msg[64] = "";
     char hum_msg[64] = "";
     char press_msg[64] = "";
+    char alt_msg[64] = "";
+    char value_str[12], limit_str[12];
     
     // Verifica temperatura
     result.temperature_ok = sensor_limits_check_temperature(limits, temperature);
     if (!result.temperature_ok) {
         if (temperature < limits->min_temp) {
-            snprintf(temp_msg, sizeof(temp_msg), "Temp BAIXA: %.1f°C (min: %.1f°C) ", 
-                    temperature, limits->min_temp);
+            snprintf(temp_msg, sizeof(temp_msg), "Temp BAIXA: %s°C (min: %s°C) ", 
+                    fp_format(value_str, sizeof(value_str), temperature, 2, 1),
+                    fp_format(limit_str, sizeof(limit_str), limits->min_temp, 2, 1));
         } else {
-            snprintf(temp_msg, sizeof(temp_msg), "Temp ALTA: %.1f°C (max: %.1f°C) ", 
-                    temperature, limits->max_temp);
+            snprintf(temp_msg, sizeof(temp_msg), "Temp ALTA: %s°C (max: %s°C) ", 
+                    fp_format(value_str, sizeof(value_str), temperature, 2, 1),
+                    fp_format(limit_str, sizeof(limit_str), limits->max_temp, 2, 1));
         }
     }
     
@@ -179,11 +246,13 @@ LimitCheckResult sensor_limits_check_all(const SensorLimits* limits,
     result.humidity_ok = sensor_limits_check_humidity(limits, humidity);
     if (!result.humidity_ok) {
         if (humidity < limits->min_humidity) {
-            snprintf(hum_msg, sizeof(hum_msg), "Umid BAIXA: %.1f%% (min: %.1f%%) ", 
-                    humidity, limits->min_humidity);
+            snprintf(hum_msg, sizeof(hum_msg), "Umid BAIXA: %s%% (min: %s%%) ", 
+                    fp_format(value_str, sizeof(value_str), humidity, 2, 1),
+                    fp_format(limit_str, sizeof(limit_str), limits->min_humidity, 2, 1));
         } else {
-            snprintf(hum_msg, sizeof(hum_msg), "Umid ALTA: %.1f%% (max: %.1f%%) ", 
-                    humidity, limits->max_humidity);
+            snprintf(hum_msg, sizeof(hum_msg), "Umid ALTA: %s%% (max: %s%%) ", 
+                    fp_format(value_str, sizeof(value_str), humidity, 2, 1),
+                    fp_format(limit_str, sizeof(limit_str), limits->max_humidity, 2, 1));
         }
     }
     
@@ -191,85 +260,173 @@ LimitCheckResult sensor_limits_check_all(const SensorLimits* limits,
     result.pressure_ok = sensor_limits_check_pressure(limits, pressure);
     if (!result.pressure_ok) {
         if (pressure < limits->min_pressure) {
-            snprintf(press_msg, sizeof(press_msg), "Press BAIXA: %.1f hPa (min: %.1f hPa)", 
-                    pressure, limits->min_pressure);
+            snprintf(press_msg, sizeof(press_msg), "Press BAIXA: %s hPa (min: %s hPa)", 
+                    fp_format(value_str, sizeof(value_str), pressure, 2, 1),
+                    fp_format(limit_str, sizeof(limit_str), limits->min_pressure, 2, 1));
         } else {
-            snprintf(press_msg, sizeof(press_msg), "Press ALTA: %.1f hPa (max: %.1f hPa)", 
-                    pressure, limits->max_pressure);
+            snprintf(press_msg, sizeof(press_msg), "Press ALTA: %s hPa (max: %s hPa)", 
+                    fp_format(value_str, sizeof(value_str), pressure, 2, 1),
+                    fp_format(limit_str, sizeof(limit_str), limits->max_pressure, 2, 1));
+        }
+    }
+    
+    // Verifica altitude
+    result.altitude_ok = sensor_limits_check_altitude(limits, altitude);
+    if (!result.altitude_ok) {
+        if (altitude < limits->min_altitude) {
+            snprintf(alt_msg, sizeof(alt_msg), " Alt BAIXA: %s m (min: %s m)", 
+                    fp_format(value_str, sizeof(value_str), altitude, 2, 1),
+                    fp_format(limit_str, sizeof(limit_str), limits->min_altitude, 2, 1));
+        } else {
+            snprintf(alt_msg, sizeof(alt_msg), " Alt ALTA: %s m (max: %s m)", 
+                    fp_format(value_str, sizeof(value_str), altitude, 2, 1),
+                    fp_format(limit_str, sizeof(limit_str), limits->max_altitude, 2, 1));
         }
     }
     
     // Resultado geral
-    result.all_ok = result.temperature_ok && result.humidity_ok && result.pressure_ok;
+    result.all_ok = result.temperature_ok && result.humidity_ok && result.pressure_ok && result.altitude_ok;
     
     // Monta mensagem de alerta
     if (result.all_ok) {
         snprintf(result.alert_message, sizeof(result.alert_message), "Todos os sensores OK");
     } else {
-        snprintf(result.alert_message, sizeof(result.alert_message), "ALERTA: %s%s%s", 
-                temp_msg, hum_msg, press_msg);
+        snprintf(result.alert_message, sizeof(result.alert_message), "ALERTA: %s%s%s%s", 
+                temp_msg, hum_msg, press_msg, alt_msg);
     }
     
     return result;
 }
 
 // ============================================================================
-// FUNÇÕES PARA PERSISTÊNCIA (SIMULADA EM MEMÓRIA)
+// FUNÇÕES PARA PERSISTÊNCIA EM FLASH
 // ============================================================================
 
+// Dois setores logo antes do log de leituras, usados alternadamente
+#define LIMITS_FLASH_OFFSET   (FLASH_LOG_OFFSET - 2 * FLASH_SECTOR_SIZE)
+#define LIMITS_MAGIC          0x3354494Cu   // "LIT3": limites em ponto fixo + QNH
+#define LIMITS_SAVE_QUIET_MS  2000          // Espera sem novas alterações antes de gravar
+
 /**
- * Salva os limites em uma estrutura de configuração
- * Em um sistema real, isso seria salvo em EEPROM/Flash
+ * Conteúdo gravado em cada slot: a sequência maior indica o slot mais recente
  */
 typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
     SensorLimits limits;
-    uint32_t checksum;  // Para verificar integridade
-    bool valid;
+    uint32_t crc;       // CRC32 de todos os campos anteriores
 } StoredLimits;
 
-static StoredLimits stored_limits = {0};
+static uint32_t stored_sequence = 0;        // Sequência do slot válido mais recente
+static int stored_slot = -1;                // Slot válido mais recente (-1 = nenhum)
+static SensorLimits pending_limits;         // Últimos limites aguardando gravação
+static volatile bool save_pending = false;
+static absolute_time_t save_deadline;
 
 /**
- * Calcula checksum simples para verificar integridade
+ * Calcula CRC32 (polinômio 0xEDB88320) para verificar integridade
  */
-uint32_t calculate_limits_checksum(const SensorLimits* limits) {
-    uint32_t checksum = 0;
-    const uint8_t* data = (const uint8_t*)limits;
-    for (size_t i = 0; i < sizeof(SensorLimits); i++) {
-        checksum += data[i];
+uint32_t calculate_limits_checksum(const void* data, size_t len) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= bytes[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1u));
+        }
     }
-    return checksum;
+    return ~crc;
+}
+
+static const StoredLimits* limits_slot(int slot) {
+    return (const StoredLimits*)(XIP_BASE + LIMITS_FLASH_OFFSET + slot * FLASH_SECTOR_SIZE);
+}
+
+static bool limits_slot_valid(const StoredLimits* stored) {
+    return stored->magic == LIMITS_MAGIC &&
+           stored->crc == calculate_limits_checksum(stored, offsetof(StoredLimits, crc));
+}
+
+typedef struct {
+    uint32_t offset;
+    const uint8_t* page;
+} LimitsFlashOp;
+
+static void limits_flash_write(void* param) {
+    const LimitsFlashOp* op = (const LimitsFlashOp*)param;
+    flash_range_erase(op->offset, FLASH_SECTOR_SIZE);
+    flash_range_program(op->offset, op->page, FLASH_PAGE_SIZE);
 }
 
 /**
- * Salva os limites na memória (simulando persistência)
+ * Agenda a gravação dos limites. Chamadas seguidas dentro de LIMITS_SAVE_QUIET_MS
+ * resultam em uma única gravação, feita por sensor_limits_service() fora do tratamento HTTP
  */
 bool sensor_limits_save(const SensorLimits* limits) {
-    stored_limits.limits = *limits;
-    stored_limits.checksum = calculate_limits_checksum(limits);
-    stored_limits.valid = true;
-    
-    printf("Limites salvos com sucesso!\n");
+    pending_limits = *limits;
+    save_deadline = make_timeout_time_ms(LIMITS_SAVE_QUIET_MS);
+    save_pending = true;
+
+    printf("Gravação dos limites agendada\n");
     return true;
 }
 
 /**
- * Carrega os limites da memória
+ * Grava os limites pendentes no slot mais antigo quando o período de silêncio termina.
+ * Deve ser chamada periodicamente pelo loop principal
+ */
+void sensor_limits_service(void) {
+    if (!save_pending || !time_reached(save_deadline)) return;
+
+    // Copia os limites pendentes sem ser interrompido pelos callbacks HTTP
+    static uint8_t page[FLASH_PAGE_SIZE];
+    StoredLimits stored;
+    memset(&stored, 0, sizeof(stored));
+    uint32_t irq = save_and_disable_interrupts();
+    stored.limits = pending_limits;
+    save_pending = false;
+    restore_interrupts(irq);
+
+    stored.magic = LIMITS_MAGIC;
+    stored.sequence = stored_sequence + 1;
+    stored.crc = calculate_limits_checksum(&stored, offsetof(StoredLimits, crc));
+
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page, &stored, sizeof(stored));
+
+    int slot = stored_slot == 0 ? 1 : 0;
+    LimitsFlashOp op = { LIMITS_FLASH_OFFSET + slot * FLASH_SECTOR_SIZE, page };
+    if (flash_safe_execute(limits_flash_write, &op, UINT32_MAX) != PICO_OK ||
+        !limits_slot_valid(limits_slot(slot))) {
+        printf("ERRO: Falha ao gravar limites na flash!\n");
+        return;
+    }
+
+    stored_slot = slot;
+    stored_sequence = stored.sequence;
+    printf("Limites salvos na flash (slot %d, seq %lu)\n", slot, (unsigned long)stored_sequence);
+}
+
+/**
+ * Carrega os limites do slot válido mais recente da flash
  */
 bool sensor_limits_load(SensorLimits* limits) {
-    if (!stored_limits.valid) {
-        printf("Nenhum limite salvo encontrado. Usando padrões.\n");
-        return false;
+    const StoredLimits* newest = NULL;
+    for (int slot = 0; slot < 2; slot++) {
+        const StoredLimits* stored = limits_slot(slot);
+        if (limits_slot_valid(stored) && (!newest || stored->sequence > newest->sequence)) {
+            newest = stored;
+            stored_slot = slot;
+        }
     }
-    
-    // Verifica integridade
-    uint32_t current_checksum = calculate_limits_checksum(&stored_limits.limits);
-    if (current_checksum != stored_limits.checksum) {
-        printf("ERRO: Dados corrompidos! Usando limites padrão.\n");
+
+    if (!newest) {
+        printf("Nenhum limite salvo encontrado. Usando padrões.\n");
         return false;
     }
-    
-    *limits = stored_limits.limits;
+
+    stored_sequence = newest->sequence;
+    *limits = newest->limits;
     printf("Limites carregados com sucesso!\n");
     return true;
 }
@@ -278,11 +435,13 @@ bool sensor_limits_load(SensorLimits* limits) {
  * Imprime os limites atuais de forma formatada
  */
 void sensor_limits_print(const SensorLimits* limits) {
+    char a[12], b[12];
     printf("\n=== LIMITES DOS SENSORES ===\n");
-    printf("Temperatura: %.1f°C - %.1f°C\n", limits->min_temp, limits->max_temp);
-    printf("Umidade:     %.1f%% - %.1f%%\n", limits->min_humidity, limits->max_humidity);
-    printf("Pressão:     %.1f hPa - %.1f hPa\n", limits->min_pressure, limits->max_pressure);
-    printf("Altitude:    %.1f m - %.1f m\n", limits->min_altitude, limits->max_altitude);
+    printf("Temperatura: %s°C - %s°C\n", fp_format(a, sizeof(a), limits->min_temp, 2, 1), fp_format(b, sizeof(b), limits->max_temp, 2, 1));
+    printf("Umidade:     %s%% - %s%%\n", fp_format(a, sizeof(a), limits->min_humidity, 2, 1), fp_format(b, sizeof(b), limits->max_humidity, 2, 1));
+    printf("Pressão:     %s hPa - %s hPa\n", fp_format(a, sizeof(a), limits->min_pressure, 2, 1), fp_format(b, sizeof(b), limits->max_pressure, 2, 1));
+    printf("Altitude:    %s m - %s m\n", fp_format(a, sizeof(a), limits->min_altitude, 2, 1), fp_format(b, sizeof(b), limits->max_altitude, 2, 1));
+    printf("QNH:         %s hPa\n", fp_format(a, sizeof(a), limits->sea_level_pressure, 2, 2));
     printf("Alertas:     %s\n", limits->alert_enabled ? "ATIVADOS" : "DESATIVADOS");
     printf("============================\n\n");
 }
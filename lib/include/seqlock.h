@@ -0,0 +1,60 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdint.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ============================================================================
+// SEQLOCK: PUBLICAÇÃO DE UM INSTANTÂNEO COM UM ÚNICO ESCRITOR
+// ============================================================================
+// O escritor nunca espera: torna a sequência ímpar, copia os dados e a torna par
+// de novo. O leitor copia os dados e confere se a sequência era par e não mudou
+// durante a cópia; se mudou, copia outra vez. Serve para estruturas pequenas
+// lidas com frequência bem menor que a de escrita (ex.: um handler HTTP lendo
+// a última leitura publicada pelo outro núcleo).
+// Só pode haver um escritor por seqlock.
+// A escrita roda em seção crítica: se um leitor de prioridade maior no mesmo núcleo
+// preemptasse o escritor com a sequência ímpar, giraria para sempre esperando-a ficar par.
+// Assim a janela ímpar só existe enquanto o escritor executa (cópia de poucos bytes), e
+// um leitor no outro núcleo espera no máximo esse tempo. Só chame de tarefas (não de ISR).
+
+typedef struct {
+    volatile uint32_t sequence;     // Ímpar = escrita em andamento
+} SeqLock;
+
+static inline void seqlock_init(SeqLock *lock) {
+    lock->sequence = 0;
+}
+
+/**
+ * Escritor: publica size bytes de src em shared
+ */
+static inline void seqlock_write(SeqLock *lock, void *shared, const void *src, size_t size) {
+    taskENTER_CRITICAL();                         // Sem preempção com a sequência ímpar
+    uint32_t seq = lock->sequence;
+    __atomic_store_n(&lock->sequence, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);      // Sequência ímpar visível antes dos dados
+    memcpy(shared, src, size);
+    __atomic_store_n(&lock->sequence, seq + 2, __ATOMIC_RELEASE);
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * Leitor: copia para dst um instantâneo consistente de shared. Retorna o número
+ * da sequência lida (par), útil para saber se houve publicação nova
+ */
+static inline uint32_t seqlock_read(const SeqLock *lock, void *dst, const void *shared, size_t size) {
+    uint32_t before, after;
+    do {
+        before = __atomic_load_n(&lock->sequence, __ATOMIC_ACQUIRE);
+        if (before & 1u) continue;                  // Escrita em andamento no outro núcleo
+        memcpy(dst, shared, size);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);    // Dados lidos antes de conferir a sequência
+        after = __atomic_load_n(&lock->sequence, __ATOMIC_RELAXED);
+        if (after == before) return before;
+    } while (1);
+}
+
+#endif // SEQLOCK_H
@@ -0,0 +1,68 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// ============================================================================
+// FILA CIRCULAR SEM TRAVA (UM PRODUTOR, UM CONSUMIDOR)
+// ============================================================================
+// Passa itens de tamanho fixo de um núcleo para o outro sem mutex nem seção
+// crítica: só o produtor escreve head e só o consumidor escreve tail.
+// As barreiras (dmb no Cortex-M0+) garantem que o item esteja na memória antes
+// de head avançar, e que o consumidor só o leia depois de ver o novo head.
+// A capacidade deve ser potência de 2; head e tail correm livres e dão a volta
+// em 2^32, então a ocupação é sempre head - tail.
+
+typedef struct {
+    volatile uint32_t head;     // Próxima posição a escrever (só o produtor altera)
+    volatile uint32_t tail;     // Próxima posição a ler (só o consumidor altera)
+    uint32_t mask;              // Capacidade - 1
+    uint32_t item_size;
+    uint8_t *items;             // capacidade * item_size bytes
+    volatile uint32_t drops;    // Itens descartados por fila cheia (produtor)
+} SpscRing;
+
+static inline void spsc_ring_init(SpscRing *ring, void *storage, uint32_t capacity, uint32_t item_size) {
+    ring->head = 0;
+    ring->tail = 0;
+    ring->mask = capacity - 1;
+    ring->item_size = item_size;
+    ring->items = (uint8_t *)storage;
+    ring->drops = 0;
+}
+
+/**
+ * Produtor: copia o item para a fila. Retorna false (e conta o descarte) se estiver cheia
+ */
+static inline bool spsc_ring_push(SpscRing *ring, const void *item) {
+    uint32_t head = ring->head;
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (head - tail > ring->mask) {
+        ring->drops++;
+        return false;
+    }
+    memcpy(&ring->items[(head & ring->mask) * ring->item_size], item, ring->item_size);
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * Consumidor: copia o item mais antigo para out. Retorna false se a fila estiver vazia
+ */
+static inline bool spsc_ring_pop(SpscRing *ring, void *out) {
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    if (head == tail) return false;
+    memcpy(out, &ring->items[(tail & ring->mask) * ring->item_size], ring->item_size);
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// Ocupação atual (aproximada se lida do outro núcleo)
+static inline uint32_t spsc_ring_count(const SpscRing *ring) {
+    return ring->head - ring->tail;
+}
+
+#endif // SPSC_RING_H
@@ -4,6 +4,7 @@
 
 #define WIDTH 128
 #define HEIGHT 64
+#define SSD1306_MAX_PAGES (HEIGHT / 8)
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -25,19 +26,47 @@ typedef enum {
   SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
+// Framebuffer em páginas (modo de endereçamento horizontal): o byte da coluna x na página p
+// fica em ram_buffer[1 + p * width + x]; ram_buffer[0] é o byte de controle de dados (0x40).
+// shadow guarda o que já está no painel: a atualização compara os dois, registra a faixa
+// de colunas alterada em cada página e só envia essas janelas.
+//
+// Envio assíncrono: ssd1306_begin_flush monta as janelas alteradas em tx_stream, já no
+// formato do registrador IC_DATA_CMD (byte + bit de STOP no fim de cada transação), e um
+// canal DMA alimenta a FIFO de TX da I2C. O framebuffer fica livre assim que begin_flush
+// retorna: tx_stream é o segundo buffer, então o próximo quadro é desenhado enquanto o
+// anterior é transmitido
+typedef void (*ssd1306_flush_cb_t)(void *arg);
+
 typedef struct {
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
   bool external_vcc;
   uint8_t *ram_buffer;
+  uint8_t *shadow;
   size_t bufsize;
   uint8_t port_buffer[2];
+  bool force_full;                          // Próximo envio manda o quadro inteiro
+  uint8_t dirty_first[SSD1306_MAX_PAGES];   // Faixa de colunas alteradas por página
+  uint8_t dirty_last[SSD1306_MAX_PAGES];    // (first > last = página limpa)
+  uint32_t frame_bytes;                     // Bytes no barramento no último envio (com endereço)
+  uint16_t *tx_stream;                      // Palavras para IC_DATA_CMD do envio em andamento
+  size_t tx_capacity;
+  int dma_channel;
+  volatile bool dma_active;                 // DMA ainda alimentando a FIFO
+  ssd1306_flush_cb_t on_flush_done;         // Chamado na IRQ do DMA ao fim do envio (opcional)
+  void *flush_arg;
+  uint32_t abort_count;                     // Transações abortadas pelo controlador (NACK)
 } ssd1306_t;
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_invalidate(ssd1306_t *ssd);
+bool ssd1306_begin_flush(ssd1306_t *ssd);
+bool ssd1306_is_busy(ssd1306_t *ssd);
+void ssd1306_set_flush_callback(ssd1306_t *ssd, ssd1306_flush_cb_t cb, void *arg);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
@@ -0,0 +1,117 @@
+// ============================================================================
+// CORPOS JSON DAS ROTAS DE DADOS DO SERVIDOR HTTP
+// ============================================================================
+
+#ifndef STATION_JSON_H
+#define STATION_JSON_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "data_store.h"
+#include "sensor_limits.h"
+#include "alert_fx.h"
+
+// Cada função escreve o corpo em buf com snprintf e retorna o tamanho, como snprintf.
+// As rotas por valor (/temperature, /limits, /sensor_status...) ficam para outros
+// clientes; o painel usa só /api/snapshot, uma requisição por atualização
+
+/**
+ * /temperature, /humidity e /atm_pressure: {"value", "unit", "timestamp"}
+ */
+int station_json_value(char* buf, size_t size, float value, const char* unit, unsigned long timestamp) {
+    return snprintf(buf, size, "{\"value\": %.1f, \"unit\": \"%s\", \"timestamp\": %lu}", value, unit, timestamp);
+}
+
+/**
+ * /limits: limites configurados (ponto fixo convertido para as unidades do painel)
+ */
+int station_json_limits(char* buf, size_t size, const SensorLimits* limits) {
+    return snprintf(buf, size,
+        "{"
+        "\"min_temp\": %.1f,"
+        "\"max_temp\": %.1f,"
+        "\"min_hum\": %.1f,"
+        "\"max_hum\": %.1f,"
+        "\"min_press\": %.1f,"
+        "\"max_press\": %.1f,"
+        "\"min_alt\": %.1f,"
+        "\"max_alt\": %.1f,"
+        "\"qnh\": %.2f,"
+        "\"alert_enabled\": %s"
+        "}",
+        fp_to_float(limits->min_temp, 100), fp_to_float(limits->max_temp, 100),
+        fp_to_float(limits->min_humidity, 100), fp_to_float(limits->max_humidity, 100),
+        fp_to_float(limits->min_pressure, 100), fp_to_float(limits->max_pressure, 100),
+        fp_to_float(limits->min_altitude, 100), fp_to_float(limits->max_altitude, 100),
+        fp_to_float(limits->sea_level_pressure, 100),
+        limits->alert_enabled ? "true" : "false");
+}
+
+/**
+ * /sensor_status: valor e estado de cada grandeza (altitude em cm)
+ */
+int station_json_status(char* buf, size_t size, const SensorReading* reading, int32_t altitude,
+                        const LimitCheckResult* check, unsigned long timestamp) {
+    return snprintf(buf, size,
+        "{"
+        "\"temperature\": {\"value\": %.1f, \"ok\": %s},"
+        "\"humidity\": {\"value\": %.1f, \"ok\": %s},"
+        "\"pressure\": {\"value\": %.1f, \"ok\": %s},"
+        "\"altitude\": {\"value\": %.1f, \"ok\": %s},"
+        "\"all_ok\": %s,"
+        "\"alert_message\": \"%s\","
+        "\"timestamp\": %lu"
+        "}",
+        reading->temperature, check->temperature_ok ? "true" : "false",
+        reading->humidity, check->humidity_ok ? "true" : "false",
+        reading->pressure, check->pressure_ok ? "true" : "false",
+        fp_to_float(altitude, 100), check->altitude_ok ? "true" : "false",
+        check->all_ok ? "true" : "false",
+        check->alert_message,
+        timestamp);
+}
+
+/**
+ * /api/snapshot: leitura, limites, estado de cada sensor e do alerta em um JSON compacto.
+ * sequence muda a cada leitura publicada; sem leitura ainda (reading NULL), reading e
+ * status saem null e altitude, check e severity são ignorados
+ */
+int station_json_snapshot(char* buf, size_t size, uint32_t sequence, const SensorReading* reading,
+                          int32_t altitude, const SensorLimits* limits, const LimitCheckResult* check,
+                          AlertSeverity severity) {
+    static const char* const severity_names[] = { "none", "warning", "critical" };
+    char reading_json[160] = "null";
+    char status_json[128] = "null";
+    const char* message = "";
+
+    if (reading) {
+        snprintf(reading_json, sizeof(reading_json),
+            "{\"temperature\":%.1f,\"humidity\":%.1f,\"pressure\":%.1f,\"altitude\":%.1f}",
+            reading->temperature, reading->humidity, reading->pressure, fp_to_float(altitude, 100));
+        snprintf(status_json, sizeof(status_json),
+            "{\"temperature\":%s,\"humidity\":%s,\"pressure\":%s,\"altitude\":%s,\"all_ok\":%s}",
+            check->temperature_ok ? "true" : "false",
+            check->humidity_ok ? "true" : "false",
+            check->pressure_ok ? "true" : "false",
+            check->altitude_ok ? "true" : "false",
+            check->all_ok ? "true" : "false");
+        message = check->alert_message;
+    } else {
+        severity = ALERT_NONE;
+    }
+
+    return snprintf(buf, size,
+        "{\"seq\":%lu,\"reading\":%s,\"limits\":{"
+        "\"min_temp\":%.1f,\"max_temp\":%.1f,\"min_hum\":%.1f,\"max_hum\":%.1f,"
+        "\"min_press\":%.1f,\"max_press\":%.1f,\"min_alt\":%.1f,\"max_alt\":%.1f,\"qnh\":%.2f},"
+        "\"status\":%s,\"alert\":{\"enabled\":%s,\"severity\":\"%s\",\"message\":\"%s\"}}",
+        (unsigned long)sequence, reading_json,
+        fp_to_float(limits->min_temp, 100), fp_to_float(limits->max_temp, 100),
+        fp_to_float(limits->min_humidity, 100), fp_to_float(limits->max_humidity, 100),
+        fp_to_float(limits->min_pressure, 100), fp_to_float(limits->max_pressure, 100),
+        fp_to_float(limits->min_altitude, 100), fp_to_float(limits->max_altitude, 100),
+        fp_to_float(limits->sea_level_pressure, 100),
+        status_json, limits->alert_enabled ? "true" : "false", severity_names[severity], message);
+}
+
+#endif // STATION_JSON_H
@@ -0,0 +1,15 @@
+#ifndef TASK_STATS_H
+#define TASK_STATS_H
+
+#include <stdint.h>
+
+// Relatório das tarefas do FreeRTOS: tempo de CPU (contador de 1 MHz, ver
+// FreeRTOSConfig.h) e menor folga de pilha de cada tarefa, além do heap livre.
+// O uso de CPU é calculado sobre o intervalo desde o relatório anterior
+
+#define TASK_STATS_MAX_TASKS 16
+
+// Imprime uma linha por tarefa (nome, prioridade, CPU no intervalo, CPU total, folga de pilha)
+void task_stats_print(void);
+
+#endif // TASK_STATS_H
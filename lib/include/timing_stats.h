@@ -0,0 +1,43 @@
+#ifndef TIMING_STATS_H
+#define TIMING_STATS_H
+
+#include <stdint.h>
+
+// Estatística de tempos em microssegundos (mínimo, máximo e média) para os
+// relatórios periódicos: intervalo entre amostras e latência das requisições HTTP.
+// Cada instância tem um único escritor; outros núcleos leem cópias via seqlock
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+} TimingStats;
+
+static inline void timing_stats_reset(TimingStats *stats) {
+    stats->count = 0;
+    stats->min_us = UINT32_MAX;
+    stats->max_us = 0;
+    stats->sum_us = 0;
+}
+
+static inline void timing_stats_add(TimingStats *stats, uint32_t us) {
+    stats->count++;
+    stats->sum_us += us;
+    if (us < stats->min_us) stats->min_us = us;
+    if (us > stats->max_us) stats->max_us = us;
+}
+
+static inline uint32_t timing_stats_avg(const TimingStats *stats) {
+    return stats->count ? (uint32_t)(stats->sum_us / stats->count) : 0;
+}
+
+// Maior desvio, para mais ou para menos, em relação ao valor nominal
+static inline uint32_t timing_stats_jitter(const TimingStats *stats, uint32_t nominal_us) {
+    if (stats->count == 0) return 0;
+    uint32_t late = stats->max_us > nominal_us ? stats->max_us - nominal_us : 0;
+    uint32_t early = stats->min_us < nominal_us ? nominal_us - stats->min_us : 0;
+    return late > early ? late : early;
+}
+
+#endif // TIMING_STATS_H
@@ -4,6 +4,8 @@
 #include "hardware/pio.h"
 
 #define NUM_PIXELS 25
+#define WS2812_COLS 5
+#define WS2812_ROWS 5
 typedef struct {
     uint8_t r;
     uint8_t g;
@@ -11,9 +13,48 @@ typedef struct {
     char *name;
 } color_t;
 
-static inline void put_pixel(uint32_t pixel_grb);
+// Framebuffer por pixel: os desenhos alteram só a RAM da tarefa que desenha;
+// ws2812_publish() copia o quadro pronto para o quadro publicado, e ws2812_show*()
+// (chamadas pelo timer de alert_fx) leem só o publicado, aplicam gamma e brilho por
+// tabela e entregam o quadro ao PIO por DMA, sem bloquear. Um quadro desenhado pela
+// metade nunca é enviado
 
-static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b);
+// Configura o DMA para a state machine já inicializada com ws2812_program_init
+void ws2812_init(PIO pio, uint sm);
+
+// Brilho global em % (recalcula a tabela de gamma/brilho)
+void ws2812_set_brightness(uint8_t percent);
+
+void ws2812_set_pixel(int index, uint8_t r, uint8_t g, uint8_t b);
+void ws2812_fill(uint8_t r, uint8_t g, uint8_t b);
+void ws2812_clear(void);
+
+// Índice do LED na coluna x (0 = esquerda) e linha y (0 = embaixo); -1 fora da matriz
+int ws2812_index(int x, int y);
+
+// Barra vertical na coluna x com 'level' LEDs acesos a partir de baixo (0 a WS2812_ROWS)
+void ws2812_draw_bar(int x, int level, uint8_t r, uint8_t g, uint8_t b);
+
+// Publica o framebuffer desenhado (cópia sob spin lock; seguro contra o timer em outro núcleo)
+void ws2812_publish(void);
+
+// Há quadro publicado ainda não enviado?
+bool ws2812_frame_pending(void);
+
+// Inicia o envio do quadro publicado; retorna false se o anterior ainda estiver saindo
+bool ws2812_show(void);
+
+// Como ws2812_show, com o quadro escalado por scale/255 (piscar, pulsar) sem alterar o framebuffer
+bool ws2812_show_scaled(uint8_t scale);
+
+// Envia um arco-íris começando na matiz 'hue' (graus), ignorando o framebuffer
+bool ws2812_show_rainbow(uint16_t hue, uint8_t scale);
+
+// Matiz 0-359 para RGB com saturação e valor máximos
+void ws2812_hue_to_rgb(uint16_t hue, uint8_t *r, uint8_t *g, uint8_t *b);
+
+// true enquanto o DMA/PIO transmite ou o reset entre quadros não terminou
+bool ws2812_is_busy(void);
 
 void set_leds(uint8_t r, uint8_t g, uint8_t b);
 
@@ -23,8 +64,4 @@ void turn_on_leds();
 
 void set_led_intensity(int value);
 
-void rainbow_cycle(int delay_ms, int *mode);
-
-void hsv_to_rgb(float h, float s, float v, uint8_t *r, uint8_t *g, uint8_t *b);
-
 #endif
@@ -28,42 +28,49 @@ bool aht20_init(i2c_inst_t *i2c) {
     return false;  // Falhou na calibração
 }
 
-bool aht20_read(i2c_inst_t *i2c, AHT20_Data *data) {
+bool aht20_trigger(i2c_inst_t *i2c) {
     uint8_t trigger_cmd[3] = {AHT20_CMD_TRIGGER, 0x33, 0x00};
-    uint8_t buffer[6];
+    return i2c_write_blocking(i2c, AHT20_I2C_ADDR, trigger_cmd, 3, false) == 3;
+}
 
-    // Envia comando de medição
-    i2c_write_blocking(i2c, AHT20_I2C_ADDR, trigger_cmd, 3, false);
-    
-    // Aguarda até o sensor estar pronto
-    uint8_t status;
-    for (int i = 0; i < 10; i++) {
-        i2c_read_blocking(i2c, AHT20_I2C_ADDR, &status, 1, false);
-        if (!(status & AHT20_STATUS_BUSY)) {
-            break;
-        }
-        sleep_ms(10);
-    }
-    
-    // Se ainda estiver ocupado, falha na leitura
-    if (status & AHT20_STATUS_BUSY) {
-        return false;
-    }
+AHT20_Status aht20_collect(i2c_inst_t *i2c, AHT20_Data *data) {
+    uint8_t buffer[6];
 
-    // Lê os 6 bytes de dados
+    // O primeiro byte lido é o status, seguido dos 5 bytes de medição
     if (i2c_read_blocking(i2c, AHT20_I2C_ADDR, buffer, 6, false) != 6) {
-        return false;
+        return AHT20_ERROR;
+    }
+    if (buffer[0] & AHT20_STATUS_BUSY) {
+        return AHT20_BUSY;
     }
 
-    // Processa os dados de umidade (20 bits)
+    // Processa os dados de umidade (20 bits): RH = raw * 100 / 2^20 -> centi-% = raw * 625 / 2^16
     uint32_t raw_humidity = ((uint32_t)buffer[1] << 12) | ((uint32_t)buffer[2] << 4) | (buffer[3] >> 4);
-    data->humidity = (float)raw_humidity * 100.0 / 1048576.0;
+    data->humidity = (int32_t)((raw_humidity * 625u + (1u << 15)) >> 16);
 
-    // Processa os dados de temperatura (20 bits)
+    // Processa os dados de temperatura (20 bits): T = raw * 200 / 2^20 - 50 -> centi-°C = raw * 625 / 2^15 - 5000
     uint32_t raw_temp = ((uint32_t)(buffer[3] & 0x0F) << 16) | ((uint32_t)buffer[4] << 8) | buffer[5];
-    data->temperature = ((float)raw_temp * 200.0 / 1048576.0) - 50.0;
+    data->temperature = (int32_t)((raw_temp * 625u + (1u << 14)) >> 15) - 5000;
+
+    return AHT20_OK;
+}
+
+bool aht20_read(i2c_inst_t *i2c, AHT20_Data *data) {
+    // Envia comando de medição
+    if (!aht20_trigger(i2c)) {
+        return false;
+    }
+    sleep_ms(AHT20_CONVERSION_MS);
 
-    return true;
+    // Aguarda até o sensor estar pronto
+    for (int i = 0; i < 10; i++) {
+        AHT20_Status status = aht20_collect(i2c, data);
+        if (status != AHT20_BUSY) {
+            return status == AHT20_OK;
+        }
+        sleep_ms(10);
+    }
+    return false;
 }
 
 void aht20_reset(i2c_inst_t *i2c) {
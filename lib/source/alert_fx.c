@@ -0,0 +1,161 @@
+#include "alert_fx.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "ws2812.h"
+#include "buzzer.h"
+
+#define BLINK_PERIOD_MS    500
+#define PULSE_PERIOD_MS    1500
+#define PULSE_MIN_SCALE    40
+#define RAINBOW_STEP_MS    20
+#define RAINBOW_STEP_DEG   3
+
+static const BuzzerPattern warning_beep = {
+    BUZZER_ALERT_FREQ, BUZZER_ALERT_ON_MS, 0, 1, 5000
+};
+static const BuzzerPattern critical_beep = {
+    BUZZER_ALERT_FREQ, BUZZER_ALERT_ON_MS, 100, 3, 1000
+};
+
+static struct repeating_timer fx_timer;
+
+// Estado compartilhado com o callback do timer (alterado com interrupções desligadas).
+// O quadro base não fica aqui: é publicado pelo ws2812 sob o próprio spin lock
+static volatile LedEffect led_effect = LED_FX_STEADY;
+static volatile bool frame_dirty;       // Efeito trocado: reenvia mesmo com a escala igual
+static uint32_t led_phase_ms;
+static uint8_t last_scale;
+static uint16_t hue;
+
+static const BuzzerPattern *volatile buzzer_pattern;
+static uint8_t beep_index;
+static bool beep_on;
+static uint32_t step_left_ms;
+static AlertSeverity current_severity = ALERT_NONE;
+
+// ============================================================================
+// LEDS
+// ============================================================================
+
+static uint8_t effect_scale(LedEffect effect, uint32_t phase) {
+    if (effect == LED_FX_BLINK) {
+        return (phase % BLINK_PERIOD_MS) < BLINK_PERIOD_MS / 2 ? 255 : 0;
+    }
+    if (effect == LED_FX_PULSE) {
+        // Triângulo entre PULSE_MIN_SCALE e 255
+        uint32_t t = phase % PULSE_PERIOD_MS;
+        uint32_t half = PULSE_PERIOD_MS / 2;
+        uint32_t ramp = t < half ? t : PULSE_PERIOD_MS - t;
+        return (uint8_t)(PULSE_MIN_SCALE + ramp * (255 - PULSE_MIN_SCALE) / half);
+    }
+    return 255;
+}
+
+static void led_tick(void) {
+    LedEffect effect = led_effect;
+    led_phase_ms += ALERT_FX_TICK_MS;
+
+    if (effect == LED_FX_RAINBOW) {
+        if (led_phase_ms >= RAINBOW_STEP_MS && ws2812_show_rainbow(hue, 255)) {
+            led_phase_ms = 0;
+            hue = (hue + RAINBOW_STEP_DEG) % 360;
+        }
+        return;
+    }
+
+    // Só envia quando a escala, o efeito ou o quadro publicado mudaram; se o envio
+    // anterior ainda estiver saindo, tenta de novo no próximo tick
+    uint8_t scale = effect_scale(effect, led_phase_ms);
+    if ((frame_dirty || ws2812_frame_pending() || scale != last_scale) && ws2812_show_scaled(scale)) {
+        frame_dirty = false;
+        last_scale = scale;
+    }
+}
+
+// ============================================================================
+// BUZZER
+// ============================================================================
+
+static void buzzer_tick(void) {
+    const BuzzerPattern *p = buzzer_pattern;
+    if (!p || p->beeps == 0) return;
+
+    if (step_left_ms > ALERT_FX_TICK_MS) {
+        step_left_ms -= ALERT_FX_TICK_MS;
+        return;
+    }
+
+    if (beep_on) {
+        // Fim do bipe: silêncio curto entre bipes ou pausa no fim do grupo
+        stop_buzzer();
+        beep_on = false;
+        if (++beep_index < p->beeps) {
+            step_left_ms = p->off_ms;
+        } else {
+            beep_index = 0;
+            step_left_ms = p->pause_ms;
+        }
+    } else {
+        play_buzzer(p->frequency);
+        beep_on = true;
+        step_left_ms = p->on_ms;
+    }
+}
+
+static bool fx_timer_callback(struct repeating_timer *t) {
+    (void)t;
+    buzzer_tick();
+    led_tick();
+    return true;
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+void alert_fx_init(void) {
+    frame_dirty = true;
+    add_repeating_timer_ms(-ALERT_FX_TICK_MS, fx_timer_callback, NULL, &fx_timer);
+}
+
+void alert_fx_set_led_effect(LedEffect effect) {
+    uint32_t irq = save_and_disable_interrupts();
+    led_effect = effect;
+    led_phase_ms = 0;
+    frame_dirty = true;
+    restore_interrupts(irq);
+}
+
+void alert_fx_set_buzzer(const BuzzerPattern *pattern) {
+    uint32_t irq = save_and_disable_interrupts();
+    stop_buzzer();
+    buzzer_pattern = pattern;
+    beep_index = 0;
+    beep_on = false;
+    step_left_ms = 0;   // O primeiro bipe começa no próximo tick
+    restore_interrupts(irq);
+}
+
+void alert_fx_set_severity(AlertSeverity severity) {
+    if (severity == current_severity && led_effect != LED_FX_RAINBOW) return;
+    current_severity = severity;
+
+    switch (severity) {
+        case ALERT_CRITICAL:
+            alert_fx_set_led_effect(LED_FX_BLINK);
+            alert_fx_set_buzzer(&critical_beep);
+            break;
+        case ALERT_WARNING:
+            alert_fx_set_led_effect(LED_FX_PULSE);
+            alert_fx_set_buzzer(&warning_beep);
+            break;
+        default:
+            alert_fx_set_led_effect(LED_FX_STEADY);
+            alert_fx_set_buzzer(NULL);
+            break;
+    }
+}
+
+void alert_fx_refresh(void) {
+    ws2812_publish();
+}
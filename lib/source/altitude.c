@@ -0,0 +1,82 @@
+#include "altitude.h"
+
+// Razão P / QNH em Q24; a tabela cobre [0,25, 1,25] em 256 intervalos de 2^16
+#define RATIO_SHIFT  24
+#define RATIO_MIN    (1u << 22)                 // 0,25
+#define STEP_SHIFT   16
+#define TABLE_STEPS  256
+
+// h(r) = 4433000 cm * (1 - r^0.1903) para r = 0,25 + i / 256, arredondado para cm
+static const int32_t altitude_table[TABLE_STEPS + 1] = {
+     1027933,  1017871,  1007935,   998119,   988421,   978838,   969367,   960005,
+      950749,   941597,   932545,   923592,   914735,   905972,   897301,   888719,
+      880225,   871816,   863491,   855248,   847085,   839000,   830992,   823058,
+      815199,   807411,   799694,   792046,   784465,   776951,   769503,   762118,
+      754795,   747535,   740334,   733193,   726110,   719084,   712115,   705200,
+      698340,   691532,   684777,   678074,   671421,   664817,   658263,   651757,
+      645298,   638885,   632518,   626196,   619919,   613685,   607495,   601346,
+      595240,   589174,   583149,   577164,   571217,   565310,   559441,   553609,
+      547815,   542057,   536335,   530648,   524997,   519380,   513797,   508248,
+      502732,   497249,   491798,   486379,   480992,   475635,   470310,   465014,
+      459749,   454513,   449306,   444128,   438978,   433856,   428762,   423696,
+      418657,   413644,   408658,   403698,   398764,   393856,   388972,   384114,
+      379280,   374471,   369686,   364925,   360187,   355473,   350782,   346113,
+      341467,   336844,   332242,   327663,   323105,   318568,   314053,   309559,
+      305085,   300632,   296199,   291787,   287394,   283021,   278668,   274333,
+      270018,   265722,   261445,   257186,   252946,   248724,   244520,   240334,
+      236165,   232014,   227881,   223764,   219665,   215583,   211517,   207468,
+      203435,   199419,   195419,   191435,   187466,   183514,   179577,   175655,
+      171749,   167858,   163982,   160121,   156274,   152443,   148626,   144823,
+      141035,   137260,   133500,   129754,   126022,   122303,   118598,   114906,
+      111228,   107563,   103911,   100272,    96647,    93034,    89434,    85846,
+       82271,    78709,    75158,    71620,    68095,    64581,    61079,    57590,
+       54112,    50645,    47191,    43748,    40316,    36896,    33487,    30089,
+       26702,    23327,    19962,    16608,    13265,     9933,     6612,     3301,
+           0,    -3290,    -6570,    -9839,   -13099,   -16348,   -19587,   -22816,
+      -26035,   -29244,   -32444,   -35634,   -38814,   -41984,   -45145,   -48297,
+      -51439,   -54572,   -57695,   -60810,   -63915,   -67011,   -70098,   -73176,
+      -76245,   -79305,   -82357,   -85399,   -88433,   -91459,   -94476,   -97484,
+     -100484,  -103475,  -106458,  -109433,  -112399,  -115357,  -118307,  -121249,
+     -124183,  -127109,  -130027,  -132937,  -135839,  -138733,  -141620,  -144498,
+     -147369,  -150233,  -153089,  -155937,  -158778,  -161611,  -164437,  -167256,
+     -170067,  -172871,  -175668,  -178457,  -181239,  -184015,  -186783,  -189544,
+     -192298,
+};
+
+// 2^48 / qnh truncado, só com divisões de 32 bits (o RP2040 tem divisor de 32 bits no SIO;
+// a de 64 bits seria rotina de software). Exige 2^16 < qnh < 2^24
+static uint32_t qnh_reciprocal(uint32_t qnh) {
+    uint32_t q = 0xFFFFFFFFu / qnh;
+    uint32_t r = 0xFFFFFFFFu % qnh + 1;     // 2^32 = q * qnh + r
+    if (r == qnh) {
+        q++;
+        r = 0;
+    }
+    // Mais 16 bits do quociente, 8 por vez (r << 8 cabe em 32 bits)
+    for (int i = 0; i < 2; i++) {
+        r <<= 8;
+        q = (q << 8) + r / qnh;
+        r %= qnh;
+    }
+    return q;
+}
+
+int32_t altitude_from_pressure(int32_t pressure, int32_t qnh) {
+    if (pressure <= 0) return altitude_table[0];
+    if (qnh < ALTITUDE_QNH_MIN) qnh = ALTITUDE_QNH_MIN;
+    if (qnh > ALTITUDE_QNH_MAX) qnh = ALTITUDE_QNH_MAX;
+
+    // Razão em Q24 = P * (2^48 / QNH) / 2^24: multiplicação 32x32 -> 64 e deslocamento
+    uint64_t ratio64 = ((uint64_t)(uint32_t)pressure * qnh_reciprocal((uint32_t)qnh)) >> RATIO_SHIFT;
+    if (ratio64 < RATIO_MIN) ratio64 = RATIO_MIN;
+    uint64_t offset64 = ratio64 - RATIO_MIN;
+    if (offset64 >= ((uint64_t)TABLE_STEPS << STEP_SHIFT)) {
+        return altitude_table[TABLE_STEPS];
+    }
+    uint32_t offset = (uint32_t)offset64;
+
+    uint32_t index = offset >> STEP_SHIFT;
+    int32_t frac = (int32_t)(offset & ((1u << STEP_SHIFT) - 1));
+    int32_t delta = altitude_table[index + 1] - altitude_table[index];   // |delta| < 2^14
+    return altitude_table[index] + (delta * frac) / (1 << STEP_SHIFT);
+}
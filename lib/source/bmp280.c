@@ -4,20 +4,69 @@
 #define ADDR _u(0x77)  // Endereço I2C do BMP280
 
 void bmp280_init(i2c_inst_t *i2c) {
-    uint8_t buf[2];
-    const uint8_t reg_config_val = ((0x04 << 5) | (0x05 << 2)) & 0xFC;
-    buf[0] = REG_CONFIG;
-    buf[1] = reg_config_val;
-   
-    i2c_write_blocking(i2c, ADDR, buf, 2, false);
+    bmp280_apply_preset(i2c, BMP280_DEFAULT_PRESET);
+}
 
-    const uint8_t reg_ctrl_meas_val = (0x01 << 5) | (0x03 << 2) | (0x03);
-    buf[0] = REG_CTRL_MEAS;
-    buf[1] = reg_ctrl_meas_val;
-    i2c_write_blocking(i2c, ADDR, buf, 2, false);
+void bmp280_configure(i2c_inst_t *i2c, const bmp280_config_t *config) {
+    // Escritas em config podem ser ignoradas em modo normal: coloca o sensor em sleep antes
+    uint8_t sleep_buf[2] = { REG_CTRL_MEAS, BMP280_MODE_SLEEP };
+    i2c_write_blocking(i2c, ADDR, sleep_buf, 2, false);
+
+    // config e ctrl_meas em uma única transação (pares registrador/valor)
+    const uint8_t reg_config_val = (uint8_t)(((config->standby & 0x07) << 5) | ((config->filter & 0x07) << 2));
+    const uint8_t reg_ctrl_meas_val = (uint8_t)(((config->osrs_t & 0x07) << 5) | ((config->osrs_p & 0x07) << 2) | (config->mode & 0x03));
+    uint8_t buf[4] = { REG_CONFIG, reg_config_val, REG_CTRL_MEAS, reg_ctrl_meas_val };
+    i2c_write_blocking(i2c, ADDR, buf, 4, false);
  //   printf("Ctrl_meas register value: %x\n", reg_ctrl_meas_val);
 }
 
+bmp280_config_t bmp280_preset_config(bmp280_preset_t preset) {
+    bmp280_config_t config;
+    config.mode = BMP280_MODE_NORMAL;
+    switch (preset) {
+        case BMP280_PRESET_INDOOR:
+            config.osrs_t = BMP280_OSRS_X2;
+            config.osrs_p = BMP280_OSRS_X16;
+            config.filter = BMP280_FILTER_16;
+            config.standby = BMP280_STANDBY_62_5_MS;
+            break;
+        case BMP280_PRESET_FAST:
+            config.osrs_t = BMP280_OSRS_X1;
+            config.osrs_p = BMP280_OSRS_X2;
+            config.filter = BMP280_FILTER_4;
+            config.standby = BMP280_STANDBY_0_5_MS;
+            break;
+        case BMP280_PRESET_WEATHER:
+        default:
+            config.osrs_t = BMP280_OSRS_X1;
+            config.osrs_p = BMP280_OSRS_X4;
+            config.filter = BMP280_FILTER_16;
+            config.standby = BMP280_STANDBY_500_MS;
+            break;
+    }
+    return config;
+}
+
+void bmp280_apply_preset(i2c_inst_t *i2c, bmp280_preset_t preset) {
+    bmp280_config_t config = bmp280_preset_config(preset);
+    bmp280_configure(i2c, &config);
+}
+
+// Tempo máximo de uma conversão (datasheet, seção 3.8.1): 1,25 + 2,3*T + 2,3*P + 0,575 ms
+uint32_t bmp280_measurement_time_us(const bmp280_config_t *config) {
+    static const uint8_t samples[] = { 0, 1, 2, 4, 8, 16 };
+    uint32_t t = config->osrs_t <= BMP280_OSRS_X16 ? samples[config->osrs_t] : 16;
+    uint32_t p = config->osrs_p <= BMP280_OSRS_X16 ? samples[config->osrs_p] : 16;
+    return 1250 + 2300 * t + (p ? 2300 * p + 575 : 0);
+}
+
+uint32_t bmp280_standby_time_us(bmp280_standby_t standby) {
+    static const uint32_t standby_us[] = { 500, 62500, 125000, 250000, 500000, 1000000, 2000000, 4000000 };
+    return standby_us[standby & 0x07];
+}
+
+// Leitura em rajada dos 6 registradores de dados; em modo normal eles sempre contêm
+// a última conversão completa (o sensor protege a leitura contra atualização parcial)
 void bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure) {
     uint8_t buf[6];
     uint8_t reg = REG_PRESSURE_MSB;
@@ -35,9 +84,8 @@ void bmp280_reset(i2c_inst_t *i2c) {
     i2c_write_blocking(i2c, ADDR, buf, 2, false);
 }
 
-// função intermediária que calcula a temperatura de resolução fina
-// usada tanto para conversões de pressão quanto de temperatura
-int32_t bmp280_convert(int32_t temp, struct bmp280_calib_param* params) {
+// calcula a temperatura de resolução fina (t_fine) usada tanto para conversões de pressão quanto de temperatura
+static inline int32_t compensate_t_fine(int32_t temp, const struct bmp280_calib_param* params) {
     // usa os 32 bits de compensação de ponto fixo implementados no datasheet
     int32_t var1, var2;
     var1 = ((((temp >> 3) - ((int32_t)params->dig_t1 << 1))) * ((int32_t)params->dig_t2)) >> 11;
@@ -45,18 +93,8 @@ int32_t bmp280_convert(int32_t temp, struct bmp280_calib_param* params) {
     return var1 + var2;
 }
 
-int32_t bmp280_convert_temp(int32_t temp, struct bmp280_calib_param* params) {
-    // Utiliza os parâmetros de calibração do BMP280 para compensar o valor de temperatura lido de seus registradores
-    int32_t t_fine = bmp280_convert(temp, params);
-    return (t_fine * 5 + 128) >> 8;
-}
-
-
-int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_calib_param* params) {
-    // Utiliza os parâmetros de calibração do BMP280 para compensar o valor de pressão lido de seus registradores
-
-    int32_t t_fine = bmp280_convert(temp, params);
-
+// compensa a pressão (Pa) a partir de um t_fine já calculado
+static inline uint32_t compensate_pressure(int32_t pressure, int32_t t_fine, const struct bmp280_calib_param* params) {
     int32_t var1, var2;
     uint32_t converted = 0.0;
     var1 = (((int32_t)t_fine) >> 1) - (int32_t)64000;
@@ -80,6 +118,42 @@ int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_ca
     return converted;
 }
 
+// função intermediária que calcula a temperatura de resolução fina
+// usada tanto para conversões de pressão quanto de temperatura
+int32_t bmp280_convert(int32_t temp, struct bmp280_calib_param* params) {
+    return compensate_t_fine(temp, params);
+}
+
+int32_t bmp280_convert_temp(int32_t temp, struct bmp280_calib_param* params) {
+    // Utiliza os parâmetros de calibração do BMP280 para compensar o valor de temperatura lido de seus registradores
+    int32_t t_fine = compensate_t_fine(temp, params);
+    return (t_fine * 5 + 128) >> 8;
+}
+
+int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_calib_param* params) {
+    // Utiliza os parâmetros de calibração do BMP280 para compensar o valor de pressão lido de seus registradores
+    return compensate_pressure(pressure, compensate_t_fine(temp, params), params);
+}
+
+void bmp280_compensate(int32_t raw_temp, int32_t raw_pressure, const struct bmp280_calib_param* params,
+                       int32_t* temp, uint32_t* pressure) {
+    // t_fine é calculado uma única vez e reaproveitado na compensação da pressão
+    int32_t t_fine = compensate_t_fine(raw_temp, params);
+    *temp = (t_fine * 5 + 128) >> 8;
+    *pressure = compensate_pressure(raw_pressure, t_fine, params);
+}
+
+void bmp280_compensate_burst(const int32_t* raw_temp, const int32_t* raw_pressure, size_t count,
+                             const struct bmp280_calib_param* params, int32_t* temp, uint32_t* pressure) {
+    // Calibração carregada uma vez para todo o lote (evita recarregar params a cada amostra)
+    const struct bmp280_calib_param p = *params;
+    for (size_t i = 0; i < count; i++) {
+        int32_t t_fine = compensate_t_fine(raw_temp[i], &p);
+        temp[i] = (t_fine * 5 + 128) >> 8;
+        pressure[i] = compensate_pressure(raw_pressure[i], t_fine, &p);
+    }
+}
+
 void bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params) {
     uint8_t buf[NUM_CALIB_PARAMS] = { 0 };
     uint8_t reg = REG_DIG_T1_LSB;
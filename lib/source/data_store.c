@@ -1,54 +1,525 @@
 #include "data_store.h"
 #include <string.h>
 
+_Static_assert(READING_ARCHIVE_BYTES <= 65536, "offsets do arquivo são de 16 bits");
+_Static_assert(READING_ARCHIVE_BYTES >= READING_CODEC_MAX_BYTES(READING_BLOCK_SIZE),
+               "o arquivo precisa comportar ao menos um bloco no pior caso");
+_Static_assert(sizeof(RollupBucket) == 24, "bucket agregado deve ter 24 bytes");
+_Static_assert((HISTORY_MINUTE_BUCKETS + HISTORY_HOUR_BUCKETS) * sizeof(RollupBucket) <= HISTORY_ROLLUP_BUDGET_BYTES,
+               "histórico agregado passa de HISTORY_ROLLUP_BUDGET_BYTES");
+
+// Buffer temporário para selar um bloco antes de copiá-lo para o arquivo
+static uint8_t seal_buffer[READING_CODEC_MAX_BYTES(READING_BLOCK_SIZE)];
+
+// Índice físico da leitura mais antiga
+static inline int oldest_index(const ReadingStore* store) {
+    int tail = store->head - store->count;
+    return tail < 0 ? tail + MAX_READINGS : tail;
+}
+
+// Converte um valor para ponto fixo int16 com arredondamento e saturação
+static inline int16_t to_fixed16(float value, float scale) {
+    float scaled = value * scale;
+    scaled += (scaled >= 0.0f) ? 0.5f : -0.5f;
+    if (scaled > 32767.0f) return 32767;
+    if (scaled < -32768.0f) return -32768;
+    return (int16_t)scaled;
+}
+
+// Converte um valor para ponto fixo uint16 com arredondamento e saturação
+static inline uint16_t to_ufixed16(float value, float scale) {
+    float scaled = value * scale + 0.5f;
+    if (scaled > 65535.0f) return 65535;
+    if (scaled < 0.0f) return 0;
+    return (uint16_t)scaled;
+}
+
+static inline void reading_pack(PackedReading* packed, const CodecSample* sample, uint32_t dt) {
+    packed->temperature = sample->temperature;
+    packed->humidity = sample->humidity;
+    packed->pressure = sample->pressure;
+    packed->dt = dt > UINT16_MAX ? UINT16_MAX : (uint16_t)dt;
+}
+
+static inline void sample_unpack(const CodecSample* sample, SensorReading* out) {
+    out->temperature = sample->temperature / READING_TEMP_SCALE;
+    out->humidity = sample->humidity / READING_HUMIDITY_SCALE;
+    out->pressure = sample->pressure / READING_PRESSURE_SCALE + READING_PRESSURE_BASE;
+    out->timestamp = sample->timestamp;
+}
+
+static inline void raw_sample(const ReadingStore* store, int index, CodecSample* out) {
+    const PackedReading* packed = &store->readings[index];
+    out->timestamp = store->block_base[index / READING_BLOCK_SIZE] + packed->dt;
+    out->temperature = packed->temperature;
+    out->humidity = packed->humidity;
+    out->pressure = packed->pressure;
+}
+
+static inline void reading_unpack(const ReadingStore* store, int index, SensorReading* out) {
+    CodecSample sample;
+    raw_sample(store, index, &sample);
+    sample_unpack(&sample, out);
+}
+
+// Número de posições do bloco (o último bloco pode ser menor que READING_BLOCK_SIZE)
+static inline int block_length(int block) {
+    int remaining = MAX_READINGS - block * READING_BLOCK_SIZE;
+    return remaining < READING_BLOCK_SIZE ? remaining : READING_BLOCK_SIZE;
+}
+
+// Divisão inteira arredondando para o mais próximo (também para valores negativos)
+static inline int32_t div_round(int32_t num, int32_t den) {
+    return num >= 0 ? (num + den / 2) / den : (num - den / 2) / den;
+}
+
+static inline int16_t clamp16(int32_t value) {
+    if (value > INT16_MAX) return INT16_MAX;
+    if (value < INT16_MIN) return INT16_MIN;
+    return (int16_t)value;
+}
+
+static inline uint16_t uclamp16(int32_t value) {
+    if (value > UINT16_MAX) return UINT16_MAX;
+    if (value < 0) return 0;
+    return (uint16_t)value;
+}
+
+static inline void accum_reset(RollupAccum* acc, int32_t value) {
+    acc->min = value;
+    acc->max = value;
+    acc->sum = value;
+}
+
+static inline void accum_update(RollupAccum* acc, int32_t value) {
+    if (value < acc->min) acc->min = value;
+    if (value > acc->max) acc->max = value;
+    acc->sum += value;
+}
+
+static inline RollupField accum_finish(const RollupAccum* acc, uint32_t count) {
+    RollupField field;
+    field.min = clamp16(acc->min);
+    field.max = clamp16(acc->max);
+    field.mean = clamp16(div_round(acc->sum, (int32_t)count));
+    return field;
+}
+
+static void tier_snapshot(const RollupTier* tier, RollupBucket* out) {
+    out->start = tier->open_start;
+    out->count = tier->open_count > UINT16_MAX ? UINT16_MAX : (uint16_t)tier->open_count;
+    out->temperature = accum_finish(&tier->temperature, tier->open_count);
+    out->humidity = accum_finish(&tier->humidity, tier->open_count);
+    out->pressure = accum_finish(&tier->pressure, tier->open_count);
+}
+
+// Acrescenta uma amostra ao nível; fecha o bucket em aberto quando o intervalo muda
+static void tier_add(RollupTier* tier, RollupBucket* buckets, int capacity,
+                     const CodecSample* sample) {
+    uint32_t timestamp = sample->timestamp;
+    int32_t temp = sample->temperature;
+    int32_t humidity = sample->humidity;
+    // Buckets guardam a pressão absoluta em deci-hPa
+    int32_t pressure = sample->pressure + READING_PRESSURE_BASE_PA / 10;
+    uint32_t start = timestamp - (timestamp % tier->period);
+
+    if (tier->open_count > 0 && start != tier->open_start) {
+        tier_snapshot(tier, &buckets[tier->head]);
+        if (++tier->head == capacity) {
+            tier->head = 0;
+        }
+        if (tier->count < capacity) {
+            tier->count++;
+        }
+        tier->open_count = 0;
+    }
+
+    if (tier->open_count == 0) {
+        tier->open_start = start;
+        accum_reset(&tier->temperature, temp);
+        accum_reset(&tier->humidity, humidity);
+        accum_reset(&tier->pressure, pressure);
+    } else {
+        accum_update(&tier->temperature, temp);
+        accum_update(&tier->humidity, humidity);
+        accum_update(&tier->pressure, pressure);
+    }
+    tier->open_count++;
+}
+
+static inline const RollupTier* tier_of(const ReadingStore* store, RollupLevel level,
+                                        const RollupBucket** buckets, int* capacity) {
+    if (level == ROLLUP_HOUR) {
+        *buckets = store->hours;
+        *capacity = HISTORY_HOUR_BUCKETS;
+        return &store->hour_tier;
+    }
+    *buckets = store->minutes;
+    *capacity = HISTORY_MINUTE_BUCKETS;
+    return &store->minute_tier;
+}
+
+static void archive_evict_oldest(ReadingStore* store) {
+    int tail = store->block_head - store->block_count;
+    if (tail < 0) tail += READING_ARCHIVE_BLOCKS;
+    store->archive_samples -= store->blocks[tail].count;
+    store->block_count--;
+}
+
+// Reserva n bytes contíguos no anel do arquivo, descartando os blocos mais antigos se preciso
+static uint32_t archive_alloc(ReadingStore* store, uint32_t n) {
+    while (true) {
+        if (store->block_count == READING_ARCHIVE_BLOCKS) {
+            archive_evict_oldest(store);
+            continue;
+        }
+        if (store->block_count == 0) {
+            store->archive_write = 0;
+            return 0;
+        }
+
+        int tail = store->block_head - store->block_count;
+        if (tail < 0) tail += READING_ARCHIVE_BLOCKS;
+        uint32_t tail_offset = store->blocks[tail].offset;
+
+        if (store->archive_write > tail_offset) {
+            // Livre: [archive_write, fim) e [0, tail_offset)
+            if (store->archive_write + n <= READING_ARCHIVE_BYTES) return store->archive_write;
+            if (n <= tail_offset) return 0;
+        } else if (store->archive_write + n <= tail_offset) {
+            // Livre: [archive_write, tail_offset)
+            return store->archive_write;
+        }
+        archive_evict_oldest(store);
+    }
+}
+
+// Comprime o bloco bruto completo e o acrescenta ao arquivo
+static void archive_seal_block(ReadingStore* store, int block) {
+    int first = block * READING_BLOCK_SIZE;
+    int length = block_length(block);
+
+    ReadingEncoder enc;
+    CodecSample sample;
+    reading_encoder_init(&enc, seal_buffer, sizeof(seal_buffer));
+    for (int i = 0; i < length; i++) {
+        raw_sample(store, first + i, &sample);
+        reading_encoder_add(&enc, &sample);
+    }
+
+    uint32_t nbytes = reading_encoder_bytes(&enc);
+    uint32_t offset = archive_alloc(store, nbytes);
+    memcpy(&store->archive[offset], seal_buffer, nbytes);
+
+    ArchiveBlock* desc = &store->blocks[store->block_head];
+    desc->first_ts = store->block_base[block];
+    desc->last_ts = sample.timestamp;
+    desc->offset = (uint16_t)offset;
+    desc->nbytes = (uint16_t)nbytes;
+    desc->count = (uint16_t)length;
+
+    if (++store->block_head == READING_ARCHIVE_BLOCKS) {
+        store->block_head = 0;
+    }
+    store->block_count++;
+    store->archive_write = offset + nbytes;
+    store->archive_samples += length;
+}
+
+static inline const ArchiveBlock* archive_block_at(const ReadingStore* store, int i) {
+    int index = store->block_head - store->block_count + i;
+    if (index < 0) index += READING_ARCHIVE_BLOCKS;
+    return &store->blocks[index];
+}
+
 void reading_store_init(ReadingStore* store) {
     // Inicializa a estrutura de armazenamento com valores padrão
     if (store) {
         memset(store, 0, sizeof(ReadingStore));
+        store->minute_tier.period = 60;
+        store->hour_tier.period = 3600;
+    }
+}
+
+void reading_store_encode(const SensorReading* reading, CodecSample* out) {
+    out->timestamp = reading->timestamp;
+    out->temperature = to_fixed16(reading->temperature, READING_TEMP_SCALE);
+    out->humidity = to_ufixed16(reading->humidity, READING_HUMIDITY_SCALE);
+    out->pressure = to_ufixed16(reading->pressure - READING_PRESSURE_BASE, READING_PRESSURE_SCALE);
+}
+
+void reading_store_decode(const CodecSample* sample, SensorReading* out) {
+    sample_unpack(sample, out);
+}
+
+// Acrescenta uma amostra já codificada
+static void store_append(ReadingStore* store, const CodecSample* sample) {
+    uint32_t timestamp = sample->timestamp;
+    int block = store->head / READING_BLOCK_SIZE;
+    int offset = store->head % READING_BLOCK_SIZE;
+
+    // O primeiro slot de um bloco define a base de tempo do bloco inteiro
+    if (offset == 0) {
+        store->block_base[block] = timestamp;
+    }
+
+    // Escreve na posição head; quando cheio, sobrescreve a leitura mais antiga
+    reading_pack(&store->readings[store->head], sample, timestamp - store->block_base[block]);
+    store->last_sample = *sample;
+    store->last_decoded = false;
+
+    // Atualiza os agregados por minuto e por hora sem reler o histórico
+    tier_add(&store->minute_tier, store->minutes, HISTORY_MINUTE_BUCKETS, sample);
+    tier_add(&store->hour_tier, store->hours, HISTORY_HOUR_BUCKETS, sample);
+
+    // Bloco completo: sela e comprime no arquivo
+    if (offset + 1 == block_length(block)) {
+        archive_seal_block(store, block);
+    }
+
+    if (++store->head == MAX_READINGS) {
+        store->head = 0;
+    }
+
+    // Slots do bloco atual ainda não reescritos pertencem à volta anterior e usam
+    // outra base de tempo, por isso saem do histórico
+    int limit = MAX_READINGS - (block_length(block) - (offset + 1));
+    if (store->count < limit) {
+        store->count++;
+    } else {
+        store->count = limit;
     }
 }
 
 void reading_store_add(ReadingStore* store, float temp, float humidity, float pressure) {
     if (!store) return;
-    
-    // Se a pilha estiver cheia, desloque todos os elementos para baixo (remova o último)
-    if (store->count == MAX_READINGS) {
-        // Desloca todos os elementos uma posição para baixo
-        for (int i = 0; i < MAX_READINGS - 1; i++) {
-            store->readings[i] = store->readings[i + 1];
-        }
-        // O contador permanece o mesmo (MAX_READINGS)
-    } else {
-        // Ainda tem espaço, incrementa o contador
-        store->count++;
+
+    SensorReading reading;
+    CodecSample sample;
+    reading.temperature = temp;
+    reading.humidity = humidity;
+    reading.pressure = pressure;
+    reading.timestamp = store->time_base + to_ms_since_boot(get_absolute_time()) / 1000;
+    reading_store_encode(&reading, &sample);
+    store_append(store, &sample);
+}
+
+void reading_store_add_fixed(ReadingStore* store, int32_t temperature, int32_t humidity, int32_t pressure) {
+    if (!store) return;
+
+    CodecSample sample;
+    sample.timestamp = store->time_base + to_ms_since_boot(get_absolute_time()) / 1000;
+    sample.temperature = clamp16(temperature);
+    sample.humidity = uclamp16(humidity);
+    sample.pressure = uclamp16(div_round(pressure - READING_PRESSURE_BASE_PA, 10));   // Pa -> deci-hPa
+    store_append(store, &sample);
+}
+
+void reading_store_add_sample(ReadingStore* store, const CodecSample* sample) {
+    if (!store || !sample) return;
+    store_append(store, sample);
+}
+
+void reading_store_set_time_base(ReadingStore* store, uint32_t base) {
+    if (store) {
+        store->time_base = base;
     }
-    
-    // Adiciona a nova leitura no topo (último índice usado)
-    SensorReading* new_reading = &store->readings[store->count - 1];
-    new_reading->temperature = temp;
-    new_reading->humidity = humidity;
-    new_reading->pressure = pressure;
-    new_reading->timestamp = to_ms_since_boot(get_absolute_time()) / 1000; // segundos desde o boot
 }
 
-const SensorReading* reading_store_get_all(ReadingStore* store, int* count) {
-    if (store && count) {
-        *count = store->count;
-        return store->readings;
+bool reading_store_get_at(const ReadingStore* store, int i, SensorReading* out) {
+    if (!store || !out || i < 0 || i >= store->count) return false;
+    int index = oldest_index(store) + i;
+    if (index >= MAX_READINGS) index -= MAX_READINGS;
+    reading_unpack(store, index, out);
+    return true;
+}
+
+const SensorReading* reading_store_get_last(ReadingStore* store) {
+    if (store && store->count > 0) {
+        if (!store->last_decoded) {
+            sample_unpack(&store->last_sample, &store->last);
+            store->last_decoded = true;
+        }
+        return &store->last;
     }
-    if (count) *count = 0;
     return NULL;
 }
 
-const SensorReading* reading_store_get_last(ReadingStore* store) {
+const CodecSample* reading_store_get_last_sample(const ReadingStore* store) {
     if (store && store->count > 0) {
-        return &store->readings[store->count - 1];
+        return &store->last_sample;
     }
     return NULL;
 }
 
+int reading_store_count(const ReadingStore* store) {
+    return store ? store->count : 0;
+}
+
+void reading_store_iter_begin(const ReadingStore* store, ReadingIterator* it) {
+    it->store = store;
+    it->index = store ? oldest_index(store) : 0;
+    it->remaining = store ? store->count : 0;
+}
+
+bool reading_store_iter_next(ReadingIterator* it, SensorReading* out) {
+    if (it->remaining <= 0) return false;
+    reading_unpack(it->store, it->index, out);
+    if (++it->index == MAX_READINGS) {
+        it->index = 0;
+    }
+    it->remaining--;
+    return true;
+}
+
+void reading_store_range_begin(const ReadingStore* store, ReadingCursor* cursor, uint32_t from, uint32_t to) {
+    memset(cursor, 0, sizeof(*cursor));
+    cursor->store = store;
+    cursor->from = from;
+    cursor->to = to;
+    cursor->block = -1;
+    cursor->raw_remaining = -1;
+}
+
+// Avança para o próximo bloco arquivado que intersecta o intervalo
+static bool cursor_next_block(ReadingCursor* cursor) {
+    const ReadingStore* store = cursor->store;
+    while (++cursor->block < store->block_count) {
+        const ArchiveBlock* desc = archive_block_at(store, cursor->block);
+        if (desc->last_ts < cursor->from) continue;
+        if (desc->first_ts > cursor->to) break;
+        reading_decoder_init(&cursor->decoder, &store->archive[desc->offset], desc->count);
+        return true;
+    }
+    cursor->block = store->block_count;
+    return false;
+}
+
+bool reading_store_range_next(ReadingCursor* cursor, SensorReading* out) {
+    const ReadingStore* store = cursor->store;
+    if (!store) return false;
+    CodecSample sample;
+
+    // Blocos comprimidos, decodificados um por vez
+    while (cursor->raw_remaining < 0) {
+        if (cursor->block >= 0 && cursor->block < store->block_count &&
+            reading_decoder_next(&cursor->decoder, &sample)) {
+            if (sample.timestamp < cursor->from) continue;
+            if (sample.timestamp > cursor->to) {
+                cursor->block = store->block_count;
+                cursor->raw_remaining = 0;
+                return false;
+            }
+            sample_unpack(&sample, out);
+            return true;
+        }
+        if (!cursor_next_block(cursor)) {
+            // Leituras do bloco aberto, ainda não seladas
+            int open = store->head % READING_BLOCK_SIZE;
+            if (open > store->count) open = store->count;
+            cursor->raw_index = store->head - open;
+            cursor->raw_remaining = open;
+        }
+    }
+
+    while (cursor->raw_remaining > 0) {
+        raw_sample(store, cursor->raw_index++, &sample);
+        cursor->raw_remaining--;
+        if (sample.timestamp < cursor->from) continue;
+        if (sample.timestamp > cursor->to) {
+            cursor->raw_remaining = 0;
+            return false;
+        }
+        sample_unpack(&sample, out);
+        return true;
+    }
+    return false;
+}
+
+bool reading_store_aggregate(const ReadingStore* store, uint32_t from, uint32_t to, ReadingAggregate* out) {
+    if (!store || !out) return false;
+    memset(out, 0, sizeof(*out));
+
+    ReadingCursor cursor;
+    SensorReading r;
+    float sum_t = 0.0f, sum_h = 0.0f, sum_p = 0.0f;
+    reading_store_range_begin(store, &cursor, from, to);
+    while (reading_store_range_next(&cursor, &r)) {
+        if (out->count == 0) {
+            out->min_temperature = out->max_temperature = r.temperature;
+            out->min_humidity = out->max_humidity = r.humidity;
+            out->min_pressure = out->max_pressure = r.pressure;
+        } else {
+            if (r.temperature < out->min_temperature) out->min_temperature = r.temperature;
+            if (r.temperature > out->max_temperature) out->max_temperature = r.temperature;
+            if (r.humidity < out->min_humidity) out->min_humidity = r.humidity;
+            if (r.humidity > out->max_humidity) out->max_humidity = r.humidity;
+            if (r.pressure < out->min_pressure) out->min_pressure = r.pressure;
+            if (r.pressure > out->max_pressure) out->max_pressure = r.pressure;
+        }
+        sum_t += r.temperature;
+        sum_h += r.humidity;
+        sum_p += r.pressure;
+        out->count++;
+    }
+    if (out->count == 0) return false;
+
+    out->mean_temperature = sum_t / out->count;
+    out->mean_humidity = sum_h / out->count;
+    out->mean_pressure = sum_p / out->count;
+    return true;
+}
+
+uint32_t reading_store_history_count(const ReadingStore* store) {
+    if (!store) return 0;
+    int open = store->head % READING_BLOCK_SIZE;
+    if (open > store->count) open = store->count;
+    return store->archive_samples + open;
+}
+
+uint32_t reading_store_archive_bytes(const ReadingStore* store) {
+    uint32_t total = 0;
+    if (!store) return 0;
+    for (int i = 0; i < store->block_count; i++) {
+        total += archive_block_at(store, i)->nbytes;
+    }
+    return total;
+}
+
+int reading_store_rollup_count(const ReadingStore* store, RollupLevel level) {
+    if (!store) return 0;
+    const RollupBucket* buckets;
+    int capacity;
+    return tier_of(store, level, &buckets, &capacity)->count;
+}
+
+const RollupBucket* reading_store_rollup_get_at(const ReadingStore* store, RollupLevel level, int i) {
+    if (!store) return NULL;
+    const RollupBucket* buckets;
+    int capacity;
+    const RollupTier* tier = tier_of(store, level, &buckets, &capacity);
+    if (i < 0 || i >= tier->count) return NULL;
+
+    int index = tier->head - tier->count + i;
+    if (index < 0) index += capacity;
+    return &buckets[index];
+}
+
+bool reading_store_rollup_current(const ReadingStore* store, RollupLevel level, RollupBucket* out) {
+    if (!store || !out) return false;
+    const RollupBucket* buckets;
+    int capacity;
+    const RollupTier* tier = tier_of(store, level, &buckets, &capacity);
+    if (tier->open_count == 0) return false;
+
+    tier_snapshot(tier, out);
+    return true;
+}
+
 void reading_store_clear(ReadingStore* store) {
     if (store) {
-        store->count = 0;
+        uint32_t time_base = store->time_base;
+        reading_store_init(store);
+        store->time_base = time_base;
     }
 }
@@ -0,0 +1,341 @@
+#include "flash_log.h"
+#include <string.h>
+
+#ifdef FLASH_LOG_HOST
+#include <stdio.h>
+#else
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#endif
+
+#define FLASH_LOG_MAGIC 0x474F4C57u   // "WLOG"
+
+_Static_assert(sizeof(FlashLogRecord) == FLASH_LOG_RECORD_SIZE, "registro do log deve ter 12 bytes");
+
+// Cabeçalho gravado na página 0 de cada setor
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
+    uint16_t reserved;
+    uint16_t crc;
+} SectorHeader;
+
+static uint16_t crc16_ccitt(const uint8_t* data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static bool is_erased(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+static bool record_valid(const FlashLogRecord* rec) {
+    return rec->crc == crc16_ccitt((const uint8_t*)rec, FLASH_LOG_RECORD_SIZE - 2);
+}
+
+// Sequências crescem módulo 2^32 pulando o 0 (reservado para "log vazio") e são comparadas
+// por distância: os setores vivos nunca estão a mais de sector_count passos uns dos outros
+static uint32_t next_sequence(uint32_t sequence) {
+    return sequence + 1 == 0 ? 1 : sequence + 1;
+}
+
+static bool sequence_newer(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) > 0;
+}
+
+static bool read_header(const FlashLog* log, uint32_t sector, SectorHeader* hdr) {
+    if (!log->io.read(log->io.ctx, sector * FLASH_LOG_SECTOR_SIZE, hdr, sizeof(*hdr))) return false;
+    return hdr->magic == FLASH_LOG_MAGIC &&
+           hdr->crc == crc16_ccitt((const uint8_t*)hdr, sizeof(*hdr) - 2);
+}
+
+static bool read_record(const FlashLog* log, uint32_t sector, uint32_t page, int slot, FlashLogRecord* rec) {
+    uint32_t offset = sector * FLASH_LOG_SECTOR_SIZE + page * FLASH_LOG_PAGE_SIZE + slot * FLASH_LOG_RECORD_SIZE;
+    return log->io.read(log->io.ctx, offset, rec, sizeof(*rec));
+}
+
+static bool page_programmed(const FlashLog* log, uint32_t sector, uint32_t page) {
+    FlashLogRecord rec;
+    read_record(log, sector, page, 0, &rec);
+    return !is_erased((const uint8_t*)&rec, sizeof(rec));
+}
+
+// Timestamp do registro válido mais recente nas páginas [1, end_page) de um setor
+static bool last_record_timestamp(const FlashLog* log, uint32_t sector, uint32_t end_page, uint32_t* timestamp) {
+    FlashLogRecord rec;
+    for (uint32_t page = end_page; page-- > 1;) {
+        for (int slot = FLASH_LOG_RECORDS_PER_PAGE - 1; slot >= 0; slot--) {
+            if (read_record(log, sector, page, slot, &rec) && record_valid(&rec)) {
+                *timestamp = rec.timestamp;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Apaga o próximo setor do rodízio e grava seu cabeçalho
+static bool open_next_sector(FlashLog* log) {
+    uint32_t sector = log->sequence == 0 ? 0 : (log->head_sector + 1) % log->sector_count;
+    uint32_t offset = sector * FLASH_LOG_SECTOR_SIZE;
+
+    if (!log->io.erase_sector(log->io.ctx, offset)) return false;
+    log->erase_count++;
+
+    uint8_t page[FLASH_LOG_PAGE_SIZE];
+    SectorHeader hdr = { FLASH_LOG_MAGIC, next_sequence(log->sequence), 0xFFFF, 0 };
+    hdr.crc = crc16_ccitt((const uint8_t*)&hdr, sizeof(hdr) - 2);
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page, &hdr, sizeof(hdr));
+    if (!log->io.program_page(log->io.ctx, offset, page)) return false;
+    log->program_count++;
+
+    log->head_sector = sector;
+    log->head_page = 1;
+    log->sequence = hdr.sequence;
+    return true;
+}
+
+bool flash_log_init(FlashLog* log, const FlashLogIO* io, uint32_t size) {
+    memset(log, 0, sizeof(*log));
+    memset(log->page, 0xFF, sizeof(log->page));
+    log->io = *io;
+    log->sector_count = size / FLASH_LOG_SECTOR_SIZE;
+    if (log->sector_count < 2) return false;
+
+    // Setor mais recente = sequência válida mais nova (lê só os cabeçalhos)
+    SectorHeader hdr;
+    for (uint32_t s = 0; s < log->sector_count; s++) {
+        if (read_header(log, s, &hdr) && hdr.sequence != 0 &&
+            (log->sequence == 0 || sequence_newer(hdr.sequence, log->sequence))) {
+            log->sequence = hdr.sequence;
+            log->head_sector = s;
+        }
+    }
+    if (log->sequence == 0) {
+        // Região nunca usada
+        return true;
+    }
+
+    // As páginas são gravadas em ordem: busca binária pela primeira página livre
+    uint32_t lo = 1, hi = FLASH_LOG_PAGES_PER_SECTOR;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (page_programmed(log, log->head_sector, mid)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    log->head_page = lo;
+
+    // Último timestamp: registro válido mais recente do setor atual; se o setor acabou de
+    // ser aberto (nenhuma página gravada), vem do fim do setor anterior do rodízio
+    if (!last_record_timestamp(log, log->head_sector, log->head_page, &log->last_timestamp)) {
+        uint32_t prev = (log->head_sector + log->sector_count - 1) % log->sector_count;
+        if (read_header(log, prev, &hdr) && next_sequence(hdr.sequence) == log->sequence) {
+            last_record_timestamp(log, prev, FLASH_LOG_PAGES_PER_SECTOR, &log->last_timestamp);
+        }
+    }
+    return true;
+}
+
+bool flash_log_flush(FlashLog* log) {
+    if (log->page_fill == 0) return true;
+
+    if (log->sequence == 0 || log->head_page >= FLASH_LOG_PAGES_PER_SECTOR) {
+        if (!open_next_sector(log)) return false;
+    }
+
+    uint32_t offset = log->head_sector * FLASH_LOG_SECTOR_SIZE + log->head_page * FLASH_LOG_PAGE_SIZE;
+    if (!log->io.program_page(log->io.ctx, offset, log->page)) return false;
+    log->program_count++;
+    log->head_page++;
+
+    memset(log->page, 0xFF, sizeof(log->page));
+    log->page_fill = 0;
+    return true;
+}
+
+bool flash_log_append(FlashLog* log, uint32_t timestamp, int16_t temperature,
+                      uint16_t humidity, uint16_t pressure) {
+    FlashLogRecord rec;
+    rec.timestamp = timestamp;
+    rec.temperature = temperature;
+    rec.humidity = humidity;
+    rec.pressure = pressure;
+    rec.crc = crc16_ccitt((const uint8_t*)&rec, FLASH_LOG_RECORD_SIZE - 2);
+
+    memcpy(&log->page[log->page_fill * FLASH_LOG_RECORD_SIZE], &rec, sizeof(rec));
+    log->last_timestamp = timestamp;
+
+    if (++log->page_fill == FLASH_LOG_RECORDS_PER_PAGE) {
+        return flash_log_flush(log);
+    }
+    return true;
+}
+
+void flash_log_iter_begin(const FlashLog* log, FlashLogIter* it) {
+    memset(it, 0, sizeof(*it));
+    it->log = log;
+    if (log->sequence == 0) {
+        it->in_buffer = true;
+        return;
+    }
+    // Começa no setor seguinte ao atual (o mais antigo após a primeira volta)
+    it->sectors_left = log->sector_count;
+    it->sector = (log->head_sector + 1) % log->sector_count;
+    it->page = 0;
+}
+
+bool flash_log_iter_next(FlashLogIter* it, FlashLogRecord* out) {
+    const FlashLog* log = it->log;
+
+    while (!it->in_buffer) {
+        if (it->page == 0) {
+            // Início de setor: pula setores apagados ou de outra sequência inválida
+            SectorHeader hdr;
+            if (!read_header(log, it->sector, &hdr) || sequence_newer(hdr.sequence, log->sequence)) {
+                if (--it->sectors_left == 0) {
+                    it->in_buffer = true;
+                    break;
+                }
+                it->sector = (it->sector + 1) % log->sector_count;
+                continue;
+            }
+            it->page = 1;
+            it->slot = 0;
+        }
+
+        uint32_t last_page = it->sector == log->head_sector ? log->head_page : FLASH_LOG_PAGES_PER_SECTOR;
+        if (it->page >= last_page) {
+            if (--it->sectors_left == 0) {
+                it->in_buffer = true;
+                break;
+            }
+            it->sector = (it->sector + 1) % log->sector_count;
+            it->page = 0;
+            continue;
+        }
+
+        read_record(log, it->sector, it->page, it->slot, out);
+        if (++it->slot == (int)FLASH_LOG_RECORDS_PER_PAGE) {
+            it->slot = 0;
+            it->page++;
+        }
+        if (record_valid(out)) return true;
+    }
+
+    // Registros ainda no buffer de página
+    if (it->slot < log->page_fill) {
+        memcpy(out, &log->page[it->slot * FLASH_LOG_RECORD_SIZE], sizeof(*out));
+        it->slot++;
+        return true;
+    }
+    return false;
+}
+
+#ifdef FLASH_LOG_HOST
+
+// ============================================================================
+// BACKEND HOST: ARQUIVO COM SEMÂNTICA DE FLASH NOR
+// ============================================================================
+
+static bool file_read(void* ctx, uint32_t offset, void* dst, size_t len) {
+    FILE* f = (FILE*)ctx;
+    return fseek(f, (long)offset, SEEK_SET) == 0 && fread(dst, 1, len, f) == len;
+}
+
+static bool file_erase_sector(void* ctx, uint32_t offset) {
+    FILE* f = (FILE*)ctx;
+    uint8_t erased[FLASH_LOG_SECTOR_SIZE];
+    memset(erased, 0xFF, sizeof(erased));
+    if (fseek(f, (long)offset, SEEK_SET) != 0) return false;
+    return fwrite(erased, 1, sizeof(erased), f) == sizeof(erased) && fflush(f) == 0;
+}
+
+static bool file_program_page(void* ctx, uint32_t offset, const uint8_t* page) {
+    FILE* f = (FILE*)ctx;
+    uint8_t current[FLASH_LOG_PAGE_SIZE];
+    if (!file_read(ctx, offset, current, sizeof(current))) return false;
+    // Gravar só leva bits de 1 para 0
+    for (size_t i = 0; i < sizeof(current); i++) {
+        current[i] &= page[i];
+    }
+    if (fseek(f, (long)offset, SEEK_SET) != 0) return false;
+    return fwrite(current, 1, sizeof(current), f) == sizeof(current) && fflush(f) == 0;
+}
+
+bool flash_log_file_io(FlashLogIO* io, const char* path, uint32_t size) {
+    FILE* f = fopen(path, "r+b");
+    if (!f) {
+        f = fopen(path, "w+b");
+        if (!f) return false;
+        for (uint32_t offset = 0; offset < size; offset += FLASH_LOG_SECTOR_SIZE) {
+            file_erase_sector(f, offset);
+        }
+    }
+    io->read = file_read;
+    io->erase_sector = file_erase_sector;
+    io->program_page = file_program_page;
+    io->ctx = f;
+    return true;
+}
+
+#else
+
+// ============================================================================
+// BACKEND PICO: FLASH INTERNA
+// ============================================================================
+
+typedef struct {
+    uint32_t offset;
+    const uint8_t* page;
+} FlashOp;
+
+static bool pico_read(void* ctx, uint32_t offset, void* dst, size_t len) {
+    (void)ctx;
+    memcpy(dst, (const void*)(XIP_BASE + FLASH_LOG_OFFSET + offset), len);
+    return true;
+}
+
+static void do_erase(void* param) {
+    const FlashOp* op = (const FlashOp*)param;
+    flash_range_erase(FLASH_LOG_OFFSET + op->offset, FLASH_LOG_SECTOR_SIZE);
+}
+
+static void do_program(void* param) {
+    const FlashOp* op = (const FlashOp*)param;
+    flash_range_program(FLASH_LOG_OFFSET + op->offset, op->page, FLASH_LOG_PAGE_SIZE);
+}
+
+static bool pico_erase_sector(void* ctx, uint32_t offset) {
+    (void)ctx;
+    FlashOp op = { offset, NULL };
+    return flash_safe_execute(do_erase, &op, UINT32_MAX) == PICO_OK;
+}
+
+static bool pico_program_page(void* ctx, uint32_t offset, const uint8_t* page) {
+    (void)ctx;
+    FlashOp op = { offset, page };
+    return flash_safe_execute(do_program, &op, UINT32_MAX) == PICO_OK;
+}
+
+void flash_log_pico_io(FlashLogIO* io) {
+    io->read = pico_read;
+    io->erase_sector = pico_erase_sector;
+    io->program_page = pico_program_page;
+    io->ctx = NULL;
+}
+
+#endif
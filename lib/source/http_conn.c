@@ -0,0 +1,119 @@
+#include "http_conn.h"
+#include "pico/time.h"
+
+_Static_assert(HTTP_MAX_CONNECTIONS > 0 && HTTP_MAX_CONNECTIONS <= 255, "HTTP_MAX_CONNECTIONS deve estar entre 1 e 255");
+
+static HttpConn pool[HTTP_MAX_CONNECTIONS];
+static uint8_t free_slots[HTTP_MAX_CONNECTIONS];    // Pilha de índices livres
+static uint32_t free_count;
+static HttpConnStats stats;
+
+void http_conn_pool_init(void) {
+    for (uint32_t i = 0; i < HTTP_MAX_CONNECTIONS; i++) {
+        pool[i].slot = (uint8_t)i;
+        free_slots[i] = (uint8_t)(HTTP_MAX_CONNECTIONS - 1 - i);   // Slot 0 sai primeiro
+    }
+    free_count = HTTP_MAX_CONNECTIONS;
+    stats.in_use = 0;
+    stats.high_water = 0;
+    stats.acquired = 0;
+    stats.rejected = 0;
+    stats.evicted = 0;
+}
+
+HttpConn* http_conn_acquire(struct tcp_pcb* pcb) {
+    if (free_count == 0) return NULL;
+    HttpConn* conn = &pool[free_slots[--free_count]];
+    http_conn_reset_response(conn);
+    conn->request_len = 0;
+    conn->idle_polls = 0;
+    conn->last_active_us = time_us_64();
+    conn->in_use = true;
+    conn->pcb = pcb;
+
+    stats.acquired++;
+    stats.in_use = HTTP_MAX_CONNECTIONS - free_count;
+    if (stats.in_use > stats.high_water) {
+        stats.high_water = stats.in_use;
+    }
+    return conn;
+}
+
+void http_conn_release(HttpConn* conn) {
+    if (!conn || !conn->in_use) return;
+    conn->in_use = false;
+    conn->pcb = NULL;
+    free_slots[free_count++] = conn->slot;
+    stats.in_use = HTTP_MAX_CONNECTIONS - free_count;
+}
+
+HttpConn* http_conn_oldest_idle(void) {
+    HttpConn* oldest = NULL;
+    for (uint32_t i = 0; i < HTTP_MAX_CONNECTIONS; i++) {
+        HttpConn* conn = &pool[i];
+        if (!conn->in_use || conn->request_len > 0 || http_conn_busy(conn)) continue;
+        if (!oldest || conn->last_active_us < oldest->last_active_us) {
+            oldest = conn;
+        }
+    }
+    if (oldest) stats.evicted++;
+    return oldest;
+}
+
+void http_conn_note_rejected(void) {
+    stats.rejected++;
+}
+
+const HttpConnStats* http_conn_stats(void) {
+    return &stats;
+}
+
+void http_conn_reset_response(HttpConn* conn) {
+    conn->len = 0;
+    conn->part_count = 0;
+    conn->part = 0;
+    conn->part_offset = 0;
+    conn->total = 0;
+    conn->sent = 0;
+    conn->static_asset = false;
+    conn->keep_alive = false;
+}
+
+void http_conn_add_part(HttpConn* conn, const char* data, size_t len, bool copy) {
+    if (conn->part_count >= HTTP_MAX_PARTS || len == 0) return;
+    HttpPart* part = &conn->parts[conn->part_count++];
+    part->data = data;
+    part->len = len;
+    part->copy = copy;
+    conn->total += len;
+}
+
+err_t http_conn_pump(HttpConn* conn, struct tcp_pcb* pcb) {
+    while (conn->part < conn->part_count) {
+        const HttpPart* part = &conn->parts[conn->part];
+        size_t remaining = part->len - conn->part_offset;
+        size_t room = tcp_sndbuf(pcb);
+        if (room == 0 || tcp_sndqueuelen(pcb) >= TCP_SND_QUEUELEN) break;
+
+        u16_t chunk = (u16_t)(remaining < room ? remaining : room);
+        u8_t flags = part->copy ? TCP_WRITE_FLAG_COPY : 0;
+        bool more = chunk < remaining || conn->part + 1 < conn->part_count;
+        if (more) flags |= TCP_WRITE_FLAG_MORE;
+
+        err_t err = tcp_write(pcb, part->data + conn->part_offset, chunk, flags);
+        if (err == ERR_MEM) break;          // Fila do lwIP cheia: continua no próximo ack
+        if (err != ERR_OK) return err;
+
+        conn->part_offset += chunk;
+        if (conn->part_offset == part->len) {
+            conn->part++;
+            conn->part_offset = 0;
+        }
+    }
+    return ERR_OK;
+}
+
+bool http_conn_acked(HttpConn* conn, u16_t len) {
+    conn->sent += len;
+    return conn->sent >= conn->total;
+}
@@ -0,0 +1,168 @@
+#include "http_request.h"
+#include <ctype.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\t';
+}
+
+// Compara n bytes sem diferenciar maiúsculas
+static bool equals_nocase(const char* a, const char* b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (tolower((unsigned char)a[i]) != tolower((unsigned char)b[i])) return false;
+    }
+    return true;
+}
+
+// Valor de q igual a zero ("0", "0.0", "0.000")
+static bool q_is_zero(const char* p, const char* end) {
+    if (p >= end || *p != '0') return false;
+    p++;
+    if (p < end && *p == '.') {
+        for (p++; p < end && *p == '0'; p++) {}
+    }
+    return p >= end || is_space(*p) || *p == ';' || *p == ',';
+}
+
+const char* http_find_header(const char* req, size_t len, const char* name, size_t* value_len) {
+    size_t name_len = strlen(name);
+    const char* end = req + len;
+
+    // Pula a linha de requisição
+    const char* line = memchr(req, '\n', len);
+    while (line && ++line < end) {
+        const char* eol = memchr(line, '\n', (size_t)(end - line));
+        const char* line_end = eol ? eol : end;
+        if (line_end > line && line_end[-1] == '\r') line_end--;
+        if (line_end == line) break;    // Linha em branco: fim dos cabeçalhos
+
+        if ((size_t)(line_end - line) > name_len && line[name_len] == ':' &&
+            equals_nocase(line, name, name_len)) {
+            const char* value = line + name_len + 1;
+            while (value < line_end && is_space(*value)) value++;
+            const char* value_end = line_end;
+            while (value_end > value && is_space(value_end[-1])) value_end--;
+            *value_len = (size_t)(value_end - value);
+            return value;
+        }
+        line = eol;
+    }
+    return NULL;
+}
+
+size_t http_request_length(const char* buf, size_t len) {
+    const char* end = buf + len;
+    const char* p = buf;
+    const char* head_end = NULL;
+    while (p + 4 <= end) {
+        const char* cr = memchr(p, '\r', (size_t)(end - p));
+        if (!cr || cr + 4 > end) break;
+        if (cr[1] == '\n' && cr[2] == '\r' && cr[3] == '\n') {
+            head_end = cr + 4;
+            break;
+        }
+        p = cr + 1;
+    }
+    if (!head_end) return 0;
+
+    size_t head_len = (size_t)(head_end - buf);
+    size_t value_len;
+    const char* value = http_find_header(buf, head_len, "Content-Length", &value_len);
+    if (!value || value_len == 0 || !isdigit((unsigned char)value[0])) return head_len;
+    unsigned long body_len = strtoul(value, NULL, 10);
+    if (body_len > SIZE_MAX - head_len) return SIZE_MAX;   // Absurdo: o chamador recusa
+    return head_len + body_len;
+}
+
+bool http_keep_alive(const char* req, size_t len) {
+    const char* eol = memchr(req, '\r', len);
+    size_t line_len = eol ? (size_t)(eol - req) : len;
+    bool http10 = line_len >= 8 && memcmp(req + line_len - 8, "HTTP/1.0", 8) == 0;
+
+    size_t value_len;
+    const char* value = http_find_header(req, len, "Connection", &value_len);
+    if (http10) {
+        return value && http_list_accepts(value, value_len, "keep-alive");
+    }
+    return !(value && http_list_accepts(value, value_len, "close"));
+}
+
+bool http_list_accepts(const char* value, size_t value_len, const char* token) {
+    size_t token_len = strlen(token);
+    const char* p = value;
+    const char* end = value + value_len;
+
+    while (p < end) {
+        while (p < end && (is_space(*p) || *p == ',')) p++;
+        const char* item = p;
+        while (p < end && *p != ',' && *p != ';' && !is_space(*p)) p++;
+        size_t item_len = (size_t)(p - item);
+
+        // Parâmetros até a próxima vírgula; só q importa
+        bool refused = false;
+        while (p < end && *p != ',') {
+            if (*p == ';') {
+                p++;
+                while (p < end && is_space(*p)) p++;
+                if (end - p > 2 && (p[0] == 'q' || p[0] == 'Q') && p[1] == '=') {
+                    refused = q_is_zero(p + 2, end);
+                }
+                continue;
+            }
+            p++;
+        }
+
+        bool match = (item_len == token_len && equals_nocase(item, token, token_len)) ||
+                     (item_len == 1 && item[0] == '*');
+        if (match) return !refused;
+    }
+    return false;
+}
+
+bool http_accepts_gzip(const char* req, size_t len) {
+    size_t value_len;
+    const char* value = http_find_header(req, len, "Accept-Encoding", &value_len);
+    return value && http_list_accepts(value, value_len, "gzip");
+}
+
+// Remove o prefixo de ETag fraca
+static const char* strip_weak(const char* p, const char* end) {
+    if (end - p > 2 && p[0] == 'W' && p[1] == '/') return p + 2;
+    return p;
+}
+
+bool http_etag_matches(const char* req, size_t len, const char* etag) {
+    size_t value_len;
+    const char* value = http_find_header(req, len, "If-None-Match", &value_len);
+    if (!value) return false;
+
+    const char* etag_end = etag + strlen(etag);
+    const char* opaque = strip_weak(etag, etag_end);
+    size_t opaque_len = (size_t)(etag_end - opaque);
+
+    const char* p = value;
+    const char* end = value + value_len;
+    while (p < end) {
+        while (p < end && (is_space(*p) || *p == ',')) p++;
+        if (p >= end) break;
+        if (*p == '*') return true;
+
+        // Entidade: [W/]"...", a vírgula pode aparecer dentro das aspas
+        const char* item = strip_weak(p, end);
+        const char* item_end = item;
+        if (item_end < end && *item_end == '"') {
+            const char* close = memchr(item_end + 1, '"', (size_t)(end - item_end - 1));
+            item_end = close ? close + 1 : end;
+        } else {
+            while (item_end < end && *item_end != ',' && !is_space(*item_end)) item_end++;
+        }
+        if ((size_t)(item_end - item) == opaque_len && memcmp(item, opaque, opaque_len) == 0) {
+            return true;
+        }
+        p = item_end;
+        while (p < end && *p != ',') p++;
+    }
+    return false;
+}
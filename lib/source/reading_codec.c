@@ -0,0 +1,163 @@
+#include "reading_codec.h"
+#include <string.h>
+
+// Escreve n bits (LSB primeiro) a partir de bitpos
+static inline void put_bits(uint8_t* data, uint32_t* bitpos, uint32_t value, int n) {
+    while (n > 0) {
+        uint32_t byte = *bitpos >> 3;
+        int shift = *bitpos & 7;
+        int take = 8 - shift;
+        if (take > n) take = n;
+
+        uint8_t mask = (uint8_t)(((1u << take) - 1) << shift);
+        data[byte] = (data[byte] & ~mask) | (uint8_t)((value << shift) & mask);
+
+        value >>= take;
+        *bitpos += take;
+        n -= take;
+    }
+}
+
+// Lê n bits (LSB primeiro) a partir de bitpos
+static inline uint32_t get_bits(const uint8_t* data, uint32_t* bitpos, int n) {
+    uint32_t value = 0;
+    int filled = 0;
+    while (filled < n) {
+        uint32_t byte = *bitpos >> 3;
+        int shift = *bitpos & 7;
+        int take = 8 - shift;
+        if (take > n - filled) take = n - filled;
+
+        uint32_t bits = (data[byte] >> shift) & ((1u << take) - 1);
+        value |= bits << filled;
+
+        *bitpos += take;
+        filled += take;
+    }
+    return value;
+}
+
+static inline uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t z) {
+    return (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+}
+
+// Tamanho em bits da codificação de um delta
+static inline int delta_bits(uint32_t z) {
+    if (z == 0) return 1;
+    if (z < (1u << 4)) return 2 + 4;
+    if (z < (1u << 8)) return 3 + 8;
+    if (z < (1u << 16)) return 4 + 16;
+    return 4 + 32;
+}
+
+static void put_delta(uint8_t* data, uint32_t* bitpos, int32_t delta) {
+    uint32_t z = zigzag(delta);
+    if (z == 0) {
+        put_bits(data, bitpos, 0x0, 1);
+    } else if (z < (1u << 4)) {
+        put_bits(data, bitpos, 0x1, 2);     // '10'
+        put_bits(data, bitpos, z, 4);
+    } else if (z < (1u << 8)) {
+        put_bits(data, bitpos, 0x3, 3);     // '110'
+        put_bits(data, bitpos, z, 8);
+    } else if (z < (1u << 16)) {
+        put_bits(data, bitpos, 0x7, 4);     // '1110'
+        put_bits(data, bitpos, z, 16);
+    } else {
+        put_bits(data, bitpos, 0xF, 4);     // '1111'
+        put_bits(data, bitpos, z & 0xFFFF, 16);
+        put_bits(data, bitpos, z >> 16, 16);
+    }
+}
+
+static int32_t get_delta(const uint8_t* data, uint32_t* bitpos) {
+    int ones = 0;
+    while (ones < 4 && get_bits(data, bitpos, 1)) {
+        ones++;
+    }
+    switch (ones) {
+        case 0: return 0;
+        case 1: return unzigzag(get_bits(data, bitpos, 4));
+        case 2: return unzigzag(get_bits(data, bitpos, 8));
+        case 3: return unzigzag(get_bits(data, bitpos, 16));
+        default: {
+            uint32_t lo = get_bits(data, bitpos, 16);
+            uint32_t hi = get_bits(data, bitpos, 16);
+            return unzigzag(lo | (hi << 16));
+        }
+    }
+}
+
+void reading_encoder_init(ReadingEncoder* enc, uint8_t* data, size_t capacity) {
+    memset(enc, 0, sizeof(*enc));
+    enc->data = data;
+    enc->capacity = capacity;
+}
+
+bool reading_encoder_add(ReadingEncoder* enc, const CodecSample* sample) {
+    if (enc->count == 0) {
+        if (enc->capacity < 10) return false;
+        put_bits(enc->data, &enc->bitpos, sample->timestamp & 0xFFFF, 16);
+        put_bits(enc->data, &enc->bitpos, sample->timestamp >> 16, 16);
+        put_bits(enc->data, &enc->bitpos, (uint16_t)sample->temperature, 16);
+        put_bits(enc->data, &enc->bitpos, sample->humidity, 16);
+        put_bits(enc->data, &enc->bitpos, sample->pressure, 16);
+    } else {
+        // Diferenças de timestamp em aritmética modular: saltos grandes não estouram int32
+        uint32_t delta = sample->timestamp - enc->prev.timestamp;
+        int32_t dod = (int32_t)(delta - enc->delta);
+        int32_t dt = (int32_t)sample->temperature - enc->prev.temperature;
+        int32_t dh = (int32_t)sample->humidity - enc->prev.humidity;
+        int32_t dp = (int32_t)sample->pressure - enc->prev.pressure;
+
+        uint32_t bits = delta_bits(zigzag(dod)) + delta_bits(zigzag(dt)) +
+                        delta_bits(zigzag(dh)) + delta_bits(zigzag(dp));
+        if (enc->bitpos + bits > enc->capacity * 8) return false;
+
+        put_delta(enc->data, &enc->bitpos, dod);
+        put_delta(enc->data, &enc->bitpos, dt);
+        put_delta(enc->data, &enc->bitpos, dh);
+        put_delta(enc->data, &enc->bitpos, dp);
+        enc->delta = delta;
+    }
+    enc->prev = *sample;
+    enc->count++;
+    return true;
+}
+
+size_t reading_encoder_bytes(const ReadingEncoder* enc) {
+    return (enc->bitpos + 7) >> 3;
+}
+
+void reading_decoder_init(ReadingDecoder* dec, const uint8_t* data, int count) {
+    memset(dec, 0, sizeof(*dec));
+    dec->data = data;
+    dec->remaining = count;
+}
+
+bool reading_decoder_next(ReadingDecoder* dec, CodecSample* out) {
+    if (dec->remaining <= 0) return false;
+
+    if (dec->bitpos == 0) {
+        uint32_t lo = get_bits(dec->data, &dec->bitpos, 16);
+        uint32_t hi = get_bits(dec->data, &dec->bitpos, 16);
+        dec->prev.timestamp = lo | (hi << 16);
+        dec->prev.temperature = (int16_t)get_bits(dec->data, &dec->bitpos, 16);
+        dec->prev.humidity = (uint16_t)get_bits(dec->data, &dec->bitpos, 16);
+        dec->prev.pressure = (uint16_t)get_bits(dec->data, &dec->bitpos, 16);
+    } else {
+        dec->delta += (uint32_t)get_delta(dec->data, &dec->bitpos);
+        dec->prev.timestamp += dec->delta;
+        dec->prev.temperature = (int16_t)(dec->prev.temperature + get_delta(dec->data, &dec->bitpos));
+        dec->prev.humidity = (uint16_t)(dec->prev.humidity + get_delta(dec->data, &dec->bitpos));
+        dec->prev.pressure = (uint16_t)(dec->prev.pressure + get_delta(dec->data, &dec->bitpos));
+    }
+
+    *out = dec->prev;
+    dec->remaining--;
+    return true;
+}
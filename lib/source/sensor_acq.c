@@ -0,0 +1,70 @@
+#include "sensor_acq.h"
+
+#define SENSOR_ACQ_RETRY_MS     10   // Intervalo entre consultas se o AHT20 ainda estiver ocupado
+#define SENSOR_ACQ_MAX_RETRIES  10
+
+void sensor_acq_init(SensorAcq *acq, i2c_inst_t *i2c) {
+    acq->i2c = i2c;
+    acq->state = SENSOR_ACQ_IDLE;
+    acq->busy_retries = 0;
+    acq->raw_temp = 0;
+    acq->raw_pressure = 0;
+    acq->aht.temperature = 0;
+    acq->aht.humidity = 0;
+    acq->aht_ok = false;
+    acq->busy_us = 0;
+    acq->cycle_us = 0;
+    acq->cycle_us_max = 0;
+}
+
+void sensor_acq_trigger(SensorAcq *acq) {
+    uint64_t start = time_us_64();
+
+    if (aht20_trigger(acq->i2c)) {
+        acq->state = SENSOR_ACQ_CONVERTING;
+        acq->ready_at = make_timeout_time_ms(AHT20_CONVERSION_MS);
+    } else {
+        // Sem resposta do AHT20: a próxima coleta lê só o BMP280
+        acq->state = SENSOR_ACQ_CONVERTING;
+        acq->ready_at = get_absolute_time();
+        acq->busy_retries = SENSOR_ACQ_MAX_RETRIES;
+    }
+
+    // O disparo encerra o ciclo de medição
+    acq->cycle_us = acq->busy_us + (uint32_t)(time_us_64() - start);
+    if (acq->cycle_us > acq->cycle_us_max) {
+        acq->cycle_us_max = acq->cycle_us;
+    }
+    acq->busy_us = 0;
+}
+
+bool sensor_acq_poll(SensorAcq *acq) {
+    if (acq->state == SENSOR_ACQ_READY) return true;
+    if (acq->state != SENSOR_ACQ_CONVERTING) return false;
+    if (!time_reached(acq->ready_at)) return false;
+
+    uint64_t start = time_us_64();
+    AHT20_Status status = AHT20_ERROR;
+    if (acq->busy_retries < SENSOR_ACQ_MAX_RETRIES) {
+        status = aht20_collect(acq->i2c, &acq->aht);
+        if (status == AHT20_BUSY) {
+            acq->busy_retries++;
+            acq->ready_at = make_timeout_time_ms(SENSOR_ACQ_RETRY_MS);
+            acq->busy_us += (uint32_t)(time_us_64() - start);
+            return false;
+        }
+    }
+
+    // O BMP280 em modo normal sempre tem uma conversão completa nos registradores
+    bmp280_read_raw(acq->i2c, &acq->raw_temp, &acq->raw_pressure);
+
+    acq->aht_ok = (status == AHT20_OK);
+    acq->busy_retries = 0;
+    acq->state = SENSOR_ACQ_READY;
+    acq->busy_us += (uint32_t)(time_us_64() - start);
+    return true;
+}
+
+void sensor_acq_consume(SensorAcq *acq) {
+    acq->state = SENSOR_ACQ_IDLE;
+}
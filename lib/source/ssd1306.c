@@ -1,5 +1,10 @@
+#include <string.h>
 #include "ssd1306.h"
 #include "font.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+static void ssd1306_dma_init(ssd1306_t *ssd);
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
   ssd->width = width;
@@ -10,13 +15,25 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
   ssd->bufsize = ssd->pages * ssd->width + 1;
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
   ssd->ram_buffer[0] = 0x40;
+  ssd->shadow = calloc(ssd->bufsize - 1, sizeof(uint8_t));
   ssd->port_buffer[0] = 0x80;
+  ssd->force_full = true;
+  ssd->frame_bytes = 0;
+
+  // Pior caso: uma janela por página (comandos + dados da largura toda)
+  ssd->tx_capacity = ssd->pages * (2 * 7 + ssd->width);
+  ssd->tx_stream = calloc(ssd->tx_capacity, sizeof(uint16_t));
+  ssd->dma_active = false;
+  ssd->on_flush_done = NULL;
+  ssd->flush_arg = NULL;
+  ssd->abort_count = 0;
+  ssd1306_dma_init(ssd);
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
   ssd1306_command(ssd, SET_DISP | 0x00);
   ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
+  ssd1306_command(ssd, 0x00);   // Endereçamento horizontal: página a página
   ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
   ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
   ssd1306_command(ssd, SET_MUX_RATIO);
@@ -42,6 +59,7 @@ void ssd1306_config(ssd1306_t *ssd) {
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  while (ssd1306_is_busy(ssd)) tight_loop_contents();
   ssd->port_buffer[1] = command;
   i2c_write_blocking(
     ssd->i2c_port,
@@ -52,24 +70,162 @@ void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   );
 }
 
+// Força o envio do quadro inteiro na próxima atualização (ex.: painel reiniciado)
+void ssd1306_invalidate(ssd1306_t *ssd) {
+  ssd->force_full = true;
+}
+
+// Compara o framebuffer com o conteúdo do painel e registra a faixa alterada de cada página
+static bool ssd1306_find_dirty(ssd1306_t *ssd) {
+  bool any = false;
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    const uint8_t *cur = &ssd->ram_buffer[1 + page * ssd->width];
+    const uint8_t *old = &ssd->shadow[page * ssd->width];
+    int first = 0, last = ssd->width - 1;
+
+    if (!ssd->force_full) {
+      while (first <= last && cur[first] == old[first]) ++first;
+      while (last >= first && cur[last] == old[last]) --last;
+    }
+    if (first > last) {
+      ssd->dirty_first[page] = 1;
+      ssd->dirty_last[page] = 0;
+    } else {
+      ssd->dirty_first[page] = (uint8_t)first;
+      ssd->dirty_last[page] = (uint8_t)last;
+      any = true;
+    }
+  }
+  ssd->force_full = false;
+  return any;
+}
+
+// Acrescenta uma transação ao stream: o último byte leva STOP, e o controlador inicia a
+// próxima transação (START + endereço) sozinho quando houver mais dados na FIFO
+static size_t stream_put(uint16_t *out, const uint8_t *bytes, size_t len, uint8_t first_byte) {
+  out[0] = first_byte;
+  for (size_t i = 0; i < len; ++i) {
+    out[1 + i] = bytes[i];
+  }
+  out[len] |= I2C_IC_DATA_CMD_STOP_BITS;
+  return len + 1;
+}
+
+// Janela: comandos de endereço em uma transação, dados na seguinte
+static size_t stream_window(ssd1306_t *ssd, uint16_t *out, uint8_t page0, uint8_t page1, uint8_t col0, uint8_t col1) {
+  uint8_t setup[6] = { SET_COL_ADDR, col0, col1, SET_PAGE_ADDR, page0, page1 };
+  size_t n = stream_put(out, setup, sizeof(setup), 0x00);
+
+  size_t start = 1 + (size_t)page0 * ssd->width + col0;
+  size_t len = (page0 == page1) ? (size_t)(col1 - col0 + 1) : (size_t)(page1 - page0 + 1) * ssd->width;
+  n += stream_put(&out[n], &ssd->ram_buffer[start], len, 0x40);
+
+  memcpy(&ssd->shadow[start - 1], &ssd->ram_buffer[start], len);
+  ssd->frame_bytes += (1 + 1 + sizeof(setup)) + (1 + 1 + len);   // Endereço + controle + bytes
+  return n;
+}
+
+// Monta o stream com todas as janelas alteradas; retorna o número de palavras
+static size_t ssd1306_build_stream(ssd1306_t *ssd) {
+  size_t n = 0;
+  ssd->frame_bytes = 0;
+  if (!ssd1306_find_dirty(ssd)) return 0;   // Nada mudou: nenhuma transferência
+
+  uint8_t page = 0;
+  while (page < ssd->pages) {
+    uint8_t first = ssd->dirty_first[page], last = ssd->dirty_last[page];
+    if (first > last) {
+      ++page;
+      continue;
+    }
+
+    // Páginas consecutivas alteradas na largura toda são contíguas: uma janela só
+    uint8_t end = page;
+    if (first == 0 && last == ssd->width - 1) {
+      while (end + 1 < ssd->pages && ssd->dirty_first[end + 1] == 0 &&
+             ssd->dirty_last[end + 1] == ssd->width - 1) {
+        ++end;
+      }
+    }
+    n += stream_window(ssd, &ssd->tx_stream[n], page, end, first, last);
+    page = end + 1;
+  }
+  return n;
+}
+
+// Um display por vez usa o DMA (é o único periférico na I2C1)
+static ssd1306_t *dma_display;
+
+static void ssd1306_dma_irq_handler(void) {
+  ssd1306_t *ssd = dma_display;
+  if (!ssd || !dma_channel_get_irq1_status(ssd->dma_channel)) return;
+  dma_channel_acknowledge_irq1(ssd->dma_channel);
+  ssd->dma_active = false;
+  if (ssd->on_flush_done) {
+    ssd->on_flush_done(ssd->flush_arg);
+  }
+}
+
+static void ssd1306_dma_init(ssd1306_t *ssd) {
+  ssd->dma_channel = dma_claim_unused_channel(true);
+  dma_channel_config c = dma_channel_get_default_config(ssd->dma_channel);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, i2c_get_dreq(ssd->i2c_port, true));
+  dma_channel_configure(ssd->dma_channel, &c, &i2c_get_hw(ssd->i2c_port)->data_cmd, NULL, 0, false);
+
+  dma_display = ssd;
+  dma_channel_set_irq1_enabled(ssd->dma_channel, true);
+  irq_add_shared_handler(DMA_IRQ_1, ssd1306_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+  irq_set_enabled(DMA_IRQ_1, true);
+}
+
+void ssd1306_set_flush_callback(ssd1306_t *ssd, ssd1306_flush_cb_t cb, void *arg) {
+  ssd->on_flush_done = cb;
+  ssd->flush_arg = arg;
+}
+
+// Ocupado enquanto o DMA alimenta a FIFO ou a I2C ainda transmite os últimos bytes
+bool ssd1306_is_busy(ssd1306_t *ssd) {
+  if (ssd->dma_active) return true;
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+    (void)hw->clr_tx_abrt;   // Libera a FIFO após um NACK; o quadro é reenviado por inteiro
+    ssd->abort_count++;
+    ssd->force_full = true;
+  }
+  return !(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_ACTIVITY_BITS);
+}
+
+// Inicia o envio das janelas alteradas sem bloquear. Retorna false se o envio anterior
+// ainda estiver em andamento (o quadro atual segue no framebuffer e vai no próximo envio)
+bool ssd1306_begin_flush(ssd1306_t *ssd) {
+  if (ssd1306_is_busy(ssd)) return false;
+
+  size_t words = ssd1306_build_stream(ssd);
+  if (words == 0) return true;
+
+  // Endereço do escravo, como em i2c_write_blocking
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = 1;
+
+  ssd->dma_active = true;
+  dma_channel_transfer_from_buffer_now(ssd->dma_channel, ssd->tx_stream, words);
+  return true;
+}
+
+// Envio bloqueante (inicialização e código que precisa do painel atualizado na volta)
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+  while (ssd1306_is_busy(ssd)) tight_loop_contents();
+  ssd1306_begin_flush(ssd);
+  while (ssd1306_is_busy(ssd)) tight_loop_contents();
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
+  uint16_t index = (y >> 3) * ssd->width + x + 1;
   uint8_t pixel = (y & 0b111);
   if (value)
     ssd->ram_buffer[index] |= (1 << pixel);
@@ -77,44 +233,67 @@ void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
     ssd->ram_buffer[index] &= ~(1 << pixel);
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
+// Máscara dos bits da página 'page' cobertos pelas linhas y0..y1 (inclusive)
+static inline uint8_t page_mask(uint8_t page, uint8_t y0, uint8_t y1) {
+  int first = y0 - page * 8;
+  int last = y1 - page * 8;
+  if (first < 0) first = 0;
+  if (last > 7) last = 7;
+  return (uint8_t)((0xFFu << first) & (0xFFu >> (7 - last)));
+}
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
-    }
+// Aplica a máscara às colunas x0..x1 de uma página: liga (value) ou desliga os bits
+static inline void page_span(ssd1306_t *ssd, uint8_t page, uint8_t x0, uint8_t x1, uint8_t mask, bool value) {
+  uint8_t *row = &ssd->ram_buffer[1 + page * ssd->width];
+  if (mask == 0xFF) {
+    memset(&row[x0], value ? 0xFF : 0x00, x1 - x0 + 1);
+  } else if (value) {
+    for (uint8_t x = x0; x <= x1; ++x) row[x] |= mask;
+  } else {
+    for (uint8_t x = x0; x <= x1; ++x) row[x] &= (uint8_t)~mask;
+  }
 }
 
+// Preenche o retângulo x0..x1, y0..y1 (inclusive) trabalhando por página
+static void fill_area(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
+  if (x1 >= ssd->width) x1 = ssd->width - 1;
+  if (y1 >= ssd->height) y1 = ssd->height - 1;
+  if (x0 > x1 || y0 > y1) return;
+  for (uint8_t page = y0 >> 3; page <= (y1 >> 3); ++page) {
+    page_span(ssd, page, x0, x1, page_mask(page, y0, y1), value);
+  }
+}
 
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  memset(&ssd->ram_buffer[1], value ? 0xFF : 0x00, ssd->bufsize - 1);
+}
 
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
-  }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
-  }
+  if (width == 0 || height == 0) return;
+  uint8_t right = left + width - 1;
+  uint8_t bottom = top + height - 1;
 
-  if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
-    }
+  ssd1306_hline(ssd, left, right, top, value);
+  ssd1306_hline(ssd, left, right, bottom, value);
+  ssd1306_vline(ssd, left, top, bottom, value);
+  ssd1306_vline(ssd, right, top, bottom, value);
+
+  if (fill && width > 2 && height > 2) {
+    fill_area(ssd, left + 1, top + 1, right - 1, bottom - 1, value);
   }
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
+    // Linhas retas vão direto para os bytes da página
+    if (y0 == y1) {
+        ssd1306_hline(ssd, x0 < x1 ? x0 : x1, x0 < x1 ? x1 : x0, y0, value);
+        return;
+    }
+    if (x0 == x1) {
+        ssd1306_vline(ssd, x0, y0 < y1 ? y0 : y1, y0 < y1 ? y1 : y0, value);
+        return;
+    }
+
     int dx = abs(x1 - x0);
     int dy = abs(y1 - y0);
 
@@ -144,16 +323,15 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 
 
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  fill_area(ssd, x0, y, x1, y, value);
 }
 
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+  fill_area(ssd, x, y0, x, y1, value);
 }
 
-// Função para desenhar um caractere
+// Função para desenhar um caractere: as colunas do glifo já estão no formato dos bytes
+// de página, então são copiadas inteiras (y alinhado) ou deslocadas em duas páginas
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
 {
   uint16_t index = 0;
@@ -169,13 +347,27 @@ void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
     index = 0; // Índice 0 corresponde ao caractere "nada" (espaço)
   }
 
-  // Desenha o caractere na tela
-  for (uint8_t i = 0; i < 8; ++i)
-  {
-    uint8_t line = font[index + i]; // Acessa a linha correspondente do caractere na fonte
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j)); // Desenha cada pixel do caractere
+  if (x >= ssd->width || y >= ssd->height) return;
+  const uint8_t *glyph = &font[index];
+  uint8_t columns = (ssd->width - x) < 8 ? (ssd->width - x) : 8;
+  uint8_t page = y >> 3;
+  uint8_t shift = y & 7;
+  uint8_t *row = &ssd->ram_buffer[1 + page * ssd->width + x];
+
+  if (shift == 0) {
+    memcpy(row, glyph, columns);
+    return;
+  }
+
+  // y desalinhado: parte de baixo do glifo na página atual, parte de cima na seguinte
+  uint8_t low_mask = (uint8_t)(0xFFu << shift);
+  for (uint8_t i = 0; i < columns; ++i) {
+    row[i] = (row[i] & (uint8_t)~low_mask) | (uint8_t)(glyph[i] << shift);
+  }
+  if (page + 1 < ssd->pages) {
+    row += ssd->width;
+    for (uint8_t i = 0; i < columns; ++i) {
+      row[i] = (row[i] & low_mask) | (uint8_t)(glyph[i] >> (8 - shift));
     }
   }
 }
@@ -0,0 +1,64 @@
+#include "task_stats.h"
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Tempo de execução de cada tarefa no relatório anterior, para o uso no intervalo
+typedef struct {
+    TaskHandle_t handle;
+    configRUN_TIME_COUNTER_TYPE run_time;
+} TaskSnapshot;
+
+static TaskSnapshot previous[TASK_STATS_MAX_TASKS];
+static UBaseType_t previous_count = 0;
+static configRUN_TIME_COUNTER_TYPE previous_total = 0;
+
+static configRUN_TIME_COUNTER_TYPE previous_run_time(TaskHandle_t handle) {
+    for (UBaseType_t i = 0; i < previous_count; i++) {
+        if (previous[i].handle == handle) return previous[i].run_time;
+    }
+    return 0;
+}
+
+// Permilagem de part sobre total, sem ponto flutuante
+static uint32_t permille(configRUN_TIME_COUNTER_TYPE part, configRUN_TIME_COUNTER_TYPE total) {
+    if (total == 0) return 0;
+    return (uint32_t)((part * 1000u + total / 2) / total);
+}
+
+void task_stats_print(void) {
+    static TaskStatus_t status[TASK_STATS_MAX_TASKS];
+    configRUN_TIME_COUNTER_TYPE total;
+    UBaseType_t count = uxTaskGetSystemState(status, TASK_STATS_MAX_TASKS, &total);
+    if (count == 0) {
+        printf("Tarefas: mais de %d tarefas, aumente TASK_STATS_MAX_TASKS\n", TASK_STATS_MAX_TASKS);
+        return;
+    }
+
+    // O total é o tempo desde o início do escalonador, somado entre os núcleos
+    configRUN_TIME_COUNTER_TYPE interval = total - previous_total;
+    interval *= configNUMBER_OF_CORES;
+    configRUN_TIME_COUNTER_TYPE elapsed = total * configNUMBER_OF_CORES;
+
+    printf("Tarefa           Pri  CPU(int)  CPU(tot)  Pilha livre\n");
+    for (UBaseType_t i = 0; i < count; i++) {
+        const TaskStatus_t *t = &status[i];
+        uint32_t recent = permille(t->ulRunTimeCounter - previous_run_time(t->xHandle), interval);
+        uint32_t overall = permille(t->ulRunTimeCounter, elapsed);
+        printf("%-16s %3lu  %3lu.%lu%%    %3lu.%lu%%    %5lu B\n",
+               t->pcTaskName, (unsigned long)t->uxCurrentPriority,
+               (unsigned long)(recent / 10), (unsigned long)(recent % 10),
+               (unsigned long)(overall / 10), (unsigned long)(overall % 10),
+               (unsigned long)(t->usStackHighWaterMark * sizeof(StackType_t)));
+    }
+    printf("Heap livre: %lu B (mínimo %lu B)\n",
+           (unsigned long)xPortGetFreeHeapSize(), (unsigned long)xPortGetMinimumEverFreeHeapSize());
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        previous[i].handle = status[i].xHandle;
+        previous[i].run_time = status[i].ulRunTimeCounter;
+    }
+    previous_count = count;
+    previous_total = total;
+}
@@ -1,7 +1,11 @@
 #include "ws2812.h"
-#include <math.h>
+#include <string.h>
 #include "pico/stdlib.h"
-// Buffer para armazenar quais LEDs estão ligados matriz 5x5
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+// Buffer para armazenar quais LEDs estão ligados matriz 5x5 (usado por set_leds)
 bool led_buffer[NUM_PIXELS] = {
     0, 0, 0, 0, 0, 
     0, 0, 0, 0, 0, 
@@ -10,31 +14,214 @@ bool led_buffer[NUM_PIXELS] = {
     0, 0, 0, 0, 0
 };
 
-float intensity = 1; // default de 10%
+// Framebuffer por pixel (RGB linear, 0-255) onde os desenhos são feitos. Só a tarefa
+// que desenha mexe nele; o timer lê apenas o quadro publicado
+static uint8_t pixels[NUM_PIXELS][3];
+
+// Último quadro publicado por ws2812_publish, lido por ws2812_show_scaled no timer.
+// Cópia e leitura sob o spin lock: o timer pode rodar no outro núcleo (SMP)
+static uint8_t published[NUM_PIXELS][3];
+static volatile bool publish_pending;
+static spin_lock_t *frame_lock;
+
+// Palavras GRB já com gamma/brilho e alinhadas para o PIO (<< 8), lidas pelo DMA.
+// São montadas em ws2812_show, então o framebuffer pode ser alterado durante o envio
+static uint32_t tx_words[NUM_PIXELS];
+
+// Correção gamma 2.2: gamma8[i] = round(255 * (i / 255)^2.2)
+static const uint8_t gamma8[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
 
-// Matriz de LEDs
-static inline void put_pixel(uint32_t pixel_grb) {
-    pio_sm_put_blocking(pio0, 0, pixel_grb << 8u);
+// gamma8 escalada pelo brilho atual; recalculada só quando o brilho muda
+static uint8_t level_lut[256];
+static uint8_t brightness = 100;
+
+static int dma_channel = -1;
+static volatile bool dma_active;
+static absolute_time_t latch_until;   // Fim do reset (>= 50 us em nível baixo) após o último bit
+
+// Tempo de um quadro a partir do disparo: 30 us por LED (24 bits a 800 kHz) mais o reset
+#define WS2812_FRAME_US  (NUM_PIXELS * 30 + 80)
+
+static void ws2812_dma_irq_handler(void) {
+    if (dma_channel < 0 || !dma_channel_get_irq1_status(dma_channel)) return;
+    dma_channel_acknowledge_irq1(dma_channel);
+    dma_active = false;
 }
 
-static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b) {
-    return ((uint32_t)(r) << 8) | ((uint32_t)(g) << 16) | (uint32_t)(b);
+static void rebuild_lut(void) {
+    for (int i = 0; i < 256; i++) {
+        level_lut[i] = (uint8_t)((gamma8[i] * brightness + 50) / 100);
+    }
 }
 
+void ws2812_init(PIO pio, uint sm) {
+    rebuild_lut();
+    frame_lock = spin_lock_instance((uint)spin_lock_claim_unused(true));
+
+    dma_channel = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(dma_channel, &c, &pio->txf[sm], tx_words, NUM_PIXELS, false);
+
+    dma_channel_set_irq1_enabled(dma_channel, true);
+    irq_add_shared_handler(DMA_IRQ_1, ws2812_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+    latch_until = get_absolute_time();
+}
+
+void ws2812_set_brightness(uint8_t percent) {
+    if (percent > 100) percent = 100;
+    if (percent != brightness) {
+        brightness = percent;
+        rebuild_lut();
+    }
+}
+
+void ws2812_set_pixel(int index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index < 0 || index >= NUM_PIXELS) return;
+    pixels[index][0] = r;
+    pixels[index][1] = g;
+    pixels[index][2] = b;
+}
+
+void ws2812_fill(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        ws2812_set_pixel(i, r, g, b);
+    }
+}
+
+void ws2812_clear(void) {
+    memset(pixels, 0, sizeof(pixels));
+}
+
+// Matriz da BitDogLab: LED 0 no canto inferior direito, linhas em zigue-zague
+int ws2812_index(int x, int y) {
+    if (x < 0 || x >= WS2812_COLS || y < 0 || y >= WS2812_ROWS) return -1;
+    return (y % 2 == 0) ? y * WS2812_COLS + (WS2812_COLS - 1 - x) : y * WS2812_COLS + x;
+}
+
+void ws2812_draw_bar(int x, int level, uint8_t r, uint8_t g, uint8_t b) {
+    for (int y = 0; y < WS2812_ROWS; y++) {
+        if (y < level) {
+            ws2812_set_pixel(ws2812_index(x, y), r, g, b);
+        } else {
+            ws2812_set_pixel(ws2812_index(x, y), 0, 0, 0);
+        }
+    }
+}
+
+void ws2812_publish(void) {
+    uint32_t save = spin_lock_blocking(frame_lock);
+    memcpy(published, pixels, sizeof(published));
+    publish_pending = true;
+    spin_unlock(frame_lock, save);
+}
+
+bool ws2812_frame_pending(void) {
+    return publish_pending;
+}
+
+bool ws2812_is_busy(void) {
+    return dma_active || !time_reached(latch_until);
+}
+
+// Palavra GRB para o PIO: gamma/brilho pela tabela e escala extra (0-255) do efeito
+static inline uint32_t grb_word(uint8_t r, uint8_t g, uint8_t b, uint8_t scale) {
+    uint32_t gr = ((uint32_t)level_lut[g] * scale + 127) / 255;
+    uint32_t rr = ((uint32_t)level_lut[r] * scale + 127) / 255;
+    uint32_t br = ((uint32_t)level_lut[b] * scale + 127) / 255;
+    return (gr << 24) | (rr << 16) | (br << 8);
+}
+
+static void start_frame(void) {
+    dma_active = true;
+    latch_until = make_timeout_time_us(WS2812_FRAME_US);
+    dma_channel_transfer_from_buffer_now(dma_channel, tx_words, NUM_PIXELS);
+}
+
+bool ws2812_show(void) {
+    return ws2812_show_scaled(255);
+}
+
+bool ws2812_show_scaled(uint8_t scale) {
+    if (dma_channel < 0 || ws2812_is_busy()) return false;
+
+    // Copia o quadro publicado sob o spin lock e converte fora dele
+    uint8_t frame[NUM_PIXELS][3];
+    uint32_t save = spin_lock_blocking(frame_lock);
+    memcpy(frame, published, sizeof(frame));
+    publish_pending = false;
+    spin_unlock(frame_lock, save);
+
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        tx_words[i] = grb_word(frame[i][0], frame[i][1], frame[i][2], scale);
+    }
+    start_frame();
+    return true;
+}
+
+// Matiz 0-359 para RGB com saturação e valor máximos, em inteiros
+void ws2812_hue_to_rgb(uint16_t hue, uint8_t *r, uint8_t *g, uint8_t *b) {
+    hue %= 360;
+    uint8_t rise = (uint8_t)((hue % 60) * 255 / 60);
+    uint8_t fall = 255 - rise;
+    switch (hue / 60) {
+        case 0:  *r = 255;  *g = rise; *b = 0;    break;
+        case 1:  *r = fall; *g = 255;  *b = 0;    break;
+        case 2:  *r = 0;    *g = 255;  *b = rise; break;
+        case 3:  *r = 0;    *g = fall; *b = 255;  break;
+        case 4:  *r = rise; *g = 0;    *b = 255;  break;
+        default: *r = 255;  *g = 0;    *b = fall; break;
+    }
+}
+
+bool ws2812_show_rainbow(uint16_t hue, uint8_t scale) {
+    if (dma_channel < 0 || ws2812_is_busy()) return false;
+
+    uint8_t r, g, b;
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        ws2812_hue_to_rgb((uint16_t)(hue + i * 360 / NUM_PIXELS), &r, &g, &b);
+        tx_words[i] = grb_word(r, g, b, scale);
+    }
+    start_frame();
+    return true;
+}
+
+// Compatibilidade: uma cor para os LEDs marcados em led_buffer
 void set_leds(uint8_t r, uint8_t g, uint8_t b) {
-    uint32_t color = urgb_u32(r*intensity, g*intensity, b*intensity);
     for (int i = 0; i < NUM_PIXELS; i++) {
         if (led_buffer[i]) {
-            put_pixel(color);
-        }
-        else {
-            put_pixel(0);
+            ws2812_set_pixel(i, r, g, b);
+        } else {
+            ws2812_set_pixel(i, 0, 0, 0);
         }
     }
+    ws2812_publish();
+    ws2812_show();
 }
 
 void set_led_intensity(int value) {
-    intensity = value / 100.0f;
+    ws2812_set_brightness(value < 0 ? 0 : (uint8_t)value);
 }
 
 void turn_on_leds() {
@@ -47,54 +234,3 @@ void clear_buffer() {
         led_buffer[i] = 0;
     }
 }
-
-void hsv_to_rgb(float h, float s, float v, uint8_t *r, uint8_t *g, uint8_t *b) {
-    float c = v * s;
-    float x = c * (1 - fabsf(fmodf(h / 60.0f, 2) - 1));
-    float m = v - c;
-
-    float r_, g_, b_;
-
-    if (h < 60) {
-        r_ = c; g_ = x; b_ = 0;
-    } else if (h < 120) {
-        r_ = x; g_ = c; b_ = 0;
-    } else if (h < 180) {
-        r_ = 0; g_ = c; b_ = x;
-    } else if (h < 240) {
-        r_ = 0; g_ = x; b_ = c;
-    } else if (h < 300) {
-        r_ = x; g_ = 0; b_ = c;
-    } else {
-        r_ = c; g_ = 0; b_ = x;
-    }
-
-    *r = (uint8_t)((r_ + m) * 255 * intensity);
-    *g = (uint8_t)((g_ + m) * 255 * intensity);
-    *b = (uint8_t)((b_ + m) * 255 * intensity);
-}
-
-void rainbow_cycle(int delay_ms, int *mode) {
-    const float sat = 1.0f;
-    const float val = 1.0f;
-    float hue = 0;
-    turn_on_leds();  // Liga todos os LEDs
-
-    while (*mode) {
-        for (int i = 0; i < NUM_PIXELS; i++) {
-            float led_hue = fmodf(hue + (360.0f / NUM_PIXELS) * i, 360.0f);
-            uint8_t r, g, b;
-            hsv_to_rgb(led_hue, sat, val, &r, &g, &b);
-            if (led_buffer[i]) {
-                put_pixel(urgb_u32(r, g, b));
-            } else {
-                put_pixel(0);
-            }
-        }
-
-        hue += 3; // velocidade do arco-íris
-        if (hue >= 360.0f) hue -= 360.0f;
-
-        sleep_ms(delay_ms);
-    }
-}
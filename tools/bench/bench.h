@@ -0,0 +1,36 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Utilitários comuns dos benchmarks e testes do host (tools/bench)
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// Relógio monotônico em nanossegundos
+static inline uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Impede que o compilador descarte um resultado calculado só para medição
+static volatile uint32_t bench_sink;
+
+static inline void bench_consume(uint32_t value) {
+    bench_sink += value;
+}
+
+// Falha de verificação: imprime e conta (o main retorna bench_failures != 0)
+static int bench_failures __attribute__((unused));
+
+#define BENCH_CHECK(cond, ...) do {                         \
+        if (!(cond)) {                                      \
+            printf("FALHA %s:%d: ", __FILE__, __LINE__);    \
+            printf(__VA_ARGS__);                            \
+            printf("\n");                                   \
+            bench_failures++;                               \
+        }                                                   \
+    } while (0)
+
+#endif // BENCH_H
@@ -0,0 +1,144 @@
+// Compensação do BMP280 (bmp280.c): conferência bit a bit com o exemplo do datasheet e
+// tempo da compensação conjunta contra o caminho antigo de duas chamadas, copiado abaixo
+// como estava antes da compensação conjunta (t_fine calculado duas vezes).
+// Referência: calibração e leituras do exemplo da seção 3.12; a temperatura é 25,08 °C e
+// a fórmula de 32 bits do datasheet (a do firmware) dá 100656 Pa para a pressão
+// (a de 64 bits daria 100653 Pa).
+
+#include "bench.h"
+#include "bmp280.h"
+
+#define SAMPLES  4096
+#define ROUNDS   200
+
+// Calibração e leituras brutas do exemplo do datasheet
+static const struct bmp280_calib_param datasheet_params = {
+    .dig_t1 = 27504, .dig_t2 = 26435, .dig_t3 = -1000,
+    .dig_p1 = 36477, .dig_p2 = -10685, .dig_p3 = 3024, .dig_p4 = 2855, .dig_p5 = 140,
+    .dig_p6 = -7, .dig_p7 = 15500, .dig_p8 = -14600, .dig_p9 = 6000,
+};
+#define DATASHEET_RAW_TEMP      519888
+#define DATASHEET_RAW_PRESSURE  415148
+#define DATASHEET_TEMP          2508        // centi-°C
+#define DATASHEET_PRESSURE_32   100656u     // Pa, fórmula de 32 bits
+
+// Caminho antigo de duas chamadas (antes de bmp280_compensate) -------------------------
+// noinline: no firmware eram funções externas de bmp280.c, chamadas uma a uma; inlinadas
+// aqui, o compilador juntaria os dois cálculos de t_fine e mediria o caminho conjunto
+
+__attribute__((noinline)) static int32_t baseline_t_fine(int32_t temp, const struct bmp280_calib_param* params) {
+    int32_t var1, var2;
+    var1 = ((((temp >> 3) - ((int32_t)params->dig_t1 << 1))) * ((int32_t)params->dig_t2)) >> 11;
+    var2 = (((((temp >> 4) - ((int32_t)params->dig_t1)) * ((temp >> 4) - ((int32_t)params->dig_t1))) >> 12) * ((int32_t)params->dig_t3)) >> 14;
+    return var1 + var2;
+}
+
+__attribute__((noinline)) static int32_t baseline_convert_temp(int32_t temp, const struct bmp280_calib_param* params) {
+    int32_t t_fine = baseline_t_fine(temp, params);
+    return (t_fine * 5 + 128) >> 8;
+}
+
+__attribute__((noinline)) static uint32_t baseline_convert_pressure(int32_t pressure, int32_t temp, const struct bmp280_calib_param* params) {
+    int32_t t_fine = baseline_t_fine(temp, params);
+
+    int32_t var1, var2;
+    uint32_t converted = 0.0;
+    var1 = (((int32_t)t_fine) >> 1) - (int32_t)64000;
+    var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * ((int32_t)params->dig_p6);
+    var2 += ((var1 * ((int32_t)params->dig_p5)) << 1);
+    var2 = (var2 >> 2) + (((int32_t)params->dig_p4) << 16);
+    var1 = (((params->dig_p3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + ((((int32_t)params->dig_p2) * var1) >> 1)) >> 18;
+    var1 = ((((32768 + var1)) * ((int32_t)params->dig_p1)) >> 15);
+    if (var1 == 0) {
+        return 0;
+    }
+    converted = (((uint32_t)(((int32_t)1048576) - pressure) - (var2 >> 12))) * 3125;
+    if (converted < 0x80000000) {
+        converted = (converted << 1) / ((uint32_t)var1);
+    } else {
+        converted = (converted / (uint32_t)var1) * 2;
+    }
+    var1 = (((int32_t)params->dig_p9) * ((int32_t)(((converted >> 3) * (converted >> 3)) >> 13))) >> 12;
+    var2 = (((int32_t)(converted >> 2)) * ((int32_t)params->dig_p8)) >> 13;
+    converted = (uint32_t)((int32_t)converted + ((var1 + var2 + params->dig_p7) >> 4));
+    return converted;
+}
+
+// ---------------------------------------------------------------------------------------
+
+static int32_t raw_temp[SAMPLES], raw_pressure[SAMPLES];
+static int32_t temp[SAMPLES];
+static uint32_t pressure[SAMPLES];
+
+static void check_datasheet(void) {
+    struct bmp280_calib_param params = datasheet_params;
+    int32_t t;
+    uint32_t p;
+
+    bmp280_compensate(DATASHEET_RAW_TEMP, DATASHEET_RAW_PRESSURE, &params, &t, &p);
+    BENCH_CHECK(t == DATASHEET_TEMP, "temperatura %ld, esperado 2508 centi-°C", (long)t);
+    BENCH_CHECK(p == DATASHEET_PRESSURE_32, "pressão %lu, esperado 100656 Pa", (unsigned long)p);
+
+    int32_t raw_t = DATASHEET_RAW_TEMP, raw_p = DATASHEET_RAW_PRESSURE;
+    bmp280_compensate_burst(&raw_t, &raw_p, 1, &params, &t, &p);
+    BENCH_CHECK(t == DATASHEET_TEMP && p == DATASHEET_PRESSURE_32, "lote: %ld centi-°C, %lu Pa", (long)t, (unsigned long)p);
+}
+
+// Caminhos novos iguais à cópia do caminho antigo em toda a faixa varrida
+static void check_against_two_calls(void) {
+    struct bmp280_calib_param params = datasheet_params;
+    bmp280_compensate_burst(raw_temp, raw_pressure, SAMPLES, &params, temp, pressure);
+    for (int i = 0; i < SAMPLES; i++) {
+        int32_t t;
+        uint32_t p;
+        bmp280_compensate(raw_temp[i], raw_pressure[i], &params, &t, &p);
+        int32_t old_t = baseline_convert_temp(raw_temp[i], &params);
+        uint32_t old_p = baseline_convert_pressure(raw_pressure[i], raw_temp[i], &params);
+        BENCH_CHECK(t == old_t && p == old_p && temp[i] == old_t && pressure[i] == old_p,
+                    "amostra %d (%ld, %ld) divergiu", i, (long)raw_temp[i], (long)raw_pressure[i]);
+    }
+}
+
+int main(void) {
+    // Varredura de leituras brutas em torno do exemplo (aprox. -10..60 °C, 300..1100 hPa)
+    for (int i = 0; i < SAMPLES; i++) {
+        raw_temp[i] = 440000 + (i * 37) % 160000;
+        raw_pressure[i] = 250000 + (i * 211) % 300000;
+    }
+
+    check_datasheet();
+    check_against_two_calls();
+
+    struct bmp280_calib_param params = datasheet_params;
+    uint64_t start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            temp[i] = baseline_convert_temp(raw_temp[i], &params);
+            pressure[i] = baseline_convert_pressure(raw_pressure[i], raw_temp[i], &params);
+        }
+        bench_consume(pressure[round % SAMPLES]);
+    }
+    double two_calls_ns = (double)(bench_now_ns() - start) / ((double)SAMPLES * ROUNDS);
+
+    start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            bmp280_compensate(raw_temp[i], raw_pressure[i], &params, &temp[i], &pressure[i]);
+        }
+        bench_consume(pressure[round % SAMPLES]);
+    }
+    double fused_ns = (double)(bench_now_ns() - start) / ((double)SAMPLES * ROUNDS);
+
+    start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        bmp280_compensate_burst(raw_temp, raw_pressure, SAMPLES, &params, temp, pressure);
+        bench_consume(pressure[round % SAMPLES]);
+    }
+    double burst_ns = (double)(bench_now_ns() - start) / ((double)SAMPLES * ROUNDS);
+
+    printf("datasheet: %s\n", bench_failures == 0 ? "25,08 °C e 100656 Pa conferem" : "DIVERGE");
+    printf("duas chamadas: %.1f ns/amostra\n", two_calls_ns);
+    printf("bmp280_compensate: %.1f ns/amostra (%.2fx)\n", fused_ns, two_calls_ns / fused_ns);
+    printf("bmp280_compensate_burst: %.1f ns/amostra (%.2fx)\n", burst_ns, two_calls_ns / burst_ns);
+    return bench_failures != 0;
+}
@@ -0,0 +1,172 @@
+// Taxa de compressão e vazão de decodificação do codec de blocos (reading_codec.c)
+// sobre uma série de leituras.
+//
+// Uso: bench_codec [arquivo.csv]
+//   Sem argumento, usa uma série sintética determinística de 7 dias (período de 1,5 s,
+//   ciclo diário de temperatura/umidade, deriva de pressão e ruído de sensor).
+//   Com argumento, lê uma série gravada: uma linha por leitura no formato
+//   timestamp_s,temperatura_C,umidade_pct,pressao_hPa (linhas que não casam são ignoradas).
+// Também verifica a volta completa (codificar -> decodificar) da série e de saltos
+// arbitrários de timestamp.
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "data_store.h"
+#include "reading_codec.h"
+
+#define TRACE_MAX        (7 * 24 * 2400)     // 7 dias a 1 leitura / 1,5 s
+#define DECODE_ROUNDS    20
+
+static CodecSample trace[TRACE_MAX];
+static uint8_t blocks[TRACE_MAX / READING_BLOCK_SIZE + 1][READING_CODEC_MAX_BYTES(READING_BLOCK_SIZE)];
+static uint16_t block_bytes[TRACE_MAX / READING_BLOCK_SIZE + 1];
+static ReadingStore store;
+
+// Gerador congruente: série igual em toda execução
+static uint32_t rng_state = 12345;
+static uint32_t rng(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static double noise(double amplitude) {
+    return ((double)(rng() % 2001) / 1000.0 - 1.0) * amplitude;
+}
+
+static void encode_reading(uint32_t timestamp, double temp, double hum, double press, CodecSample* out) {
+    SensorReading reading = { (float)temp, (float)hum, (float)press, timestamp };
+    reading_store_encode(&reading, out);
+}
+
+static int synthetic_trace(void) {
+    double pressure = 1013.0;
+    for (int i = 0; i < TRACE_MAX; i++) {
+        uint32_t ms = (uint32_t)i * 1500u;
+        double day = 2.0 * M_PI * (ms / 1000.0) / 86400.0;
+        pressure += noise(0.002);                          // Deriva lenta (frentes)
+        encode_reading(1000000u + ms / 1000u,
+                       22.0 + 5.0 * sin(day) + noise(0.02),
+                       60.0 - 15.0 * sin(day) + noise(0.05),
+                       pressure + noise(0.03),
+                       &trace[i]);
+    }
+    return TRACE_MAX;
+}
+
+static int load_trace(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        printf("não foi possível abrir %s\n", path);
+        return 0;
+    }
+    char line[128];
+    int n = 0;
+    while (n < TRACE_MAX && fgets(line, sizeof(line), f)) {
+        unsigned long ts;
+        double temp, hum, press;
+        if (sscanf(line, "%lu,%lf,%lf,%lf", &ts, &temp, &hum, &press) == 4) {
+            encode_reading((uint32_t)ts, temp, hum, press, &trace[n++]);
+        }
+    }
+    fclose(f);
+    return n;
+}
+
+static bool same_sample(const CodecSample* a, const CodecSample* b) {
+    return a->timestamp == b->timestamp && a->temperature == b->temperature &&
+           a->humidity == b->humidity && a->pressure == b->pressure;
+}
+
+// Volta completa com timestamps que saltam para qualquer valor de 32 bits
+static void check_timestamp_jumps(void) {
+    uint8_t data[READING_CODEC_MAX_BYTES(READING_BLOCK_SIZE)];
+    CodecSample in[READING_BLOCK_SIZE], out;
+    for (int round = 0; round < 1000; round++) {
+        ReadingEncoder enc;
+        reading_encoder_init(&enc, data, sizeof(data));
+        for (int i = 0; i < READING_BLOCK_SIZE; i++) {
+            in[i].timestamp = (rng() << 8) ^ rng();
+            in[i].temperature = (int16_t)rng();
+            in[i].humidity = (uint16_t)rng();
+            in[i].pressure = (uint16_t)rng();
+            BENCH_CHECK(reading_encoder_add(&enc, &in[i]), "bloco aleatório não coube no pior caso");
+        }
+        ReadingDecoder dec;
+        reading_decoder_init(&dec, data, READING_BLOCK_SIZE);
+        for (int i = 0; i < READING_BLOCK_SIZE; i++) {
+            BENCH_CHECK(reading_decoder_next(&dec, &out) && same_sample(&out, &in[i]),
+                        "salto de timestamp: amostra %d divergiu", i);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? load_trace(argv[1]) : synthetic_trace();
+    if (n == 0) return 1;
+    printf("série: %s, %d leituras\n", argc > 1 ? argv[1] : "sintética (7 dias)", n);
+
+    // Codifica em blocos de READING_BLOCK_SIZE, como o ReadingStore ao selar
+    int block_count = 0;
+    size_t packed_total = 0;
+    uint64_t start = bench_now_ns();
+    for (int first = 0; first < n; first += READING_BLOCK_SIZE, block_count++) {
+        int count = n - first < READING_BLOCK_SIZE ? n - first : READING_BLOCK_SIZE;
+        ReadingEncoder enc;
+        reading_encoder_init(&enc, blocks[block_count], sizeof(blocks[block_count]));
+        for (int i = 0; i < count; i++) {
+            reading_encoder_add(&enc, &trace[first + i]);
+        }
+        block_bytes[block_count] = (uint16_t)reading_encoder_bytes(&enc);
+        packed_total += block_bytes[block_count];
+    }
+    double encode_ns = (double)(bench_now_ns() - start) / n;
+
+    // Decodificação em fluxo, bloco a bloco (conferindo a primeira volta)
+    CodecSample out;
+    start = bench_now_ns();
+    for (int round = 0; round < DECODE_ROUNDS; round++) {
+        int index = 0;
+        for (int b = 0; b < block_count; b++) {
+            int count = n - b * READING_BLOCK_SIZE < READING_BLOCK_SIZE ? n - b * READING_BLOCK_SIZE : READING_BLOCK_SIZE;
+            ReadingDecoder dec;
+            reading_decoder_init(&dec, blocks[b], count);
+            while (reading_decoder_next(&dec, &out)) {
+                if (round == 0) {
+                    BENCH_CHECK(same_sample(&out, &trace[index]), "leitura %d divergiu", index);
+                }
+                index++;
+                bench_consume(out.pressure);
+            }
+        }
+    }
+    double decode_ns = (double)(bench_now_ns() - start) / ((double)n * DECODE_ROUNDS);
+
+    // Consulta agregada pelo ReadingStore: percorre arquivo + bloco aberto sem descomprimir tudo
+    reading_store_init(&store);
+    int stored = n < (int)(READING_ARCHIVE_BYTES / 2) ? n : (int)(READING_ARCHIVE_BYTES / 2);
+    for (int i = n - stored; i < n; i++) {
+        reading_store_add_sample(&store, &trace[i]);
+    }
+    ReadingAggregate agg;
+    uint32_t history = reading_store_history_count(&store);
+    start = bench_now_ns();
+    for (int round = 0; round < DECODE_ROUNDS; round++) {
+        reading_store_aggregate(&store, 0, UINT32_MAX, &agg);
+    }
+    double query_ns = (double)(bench_now_ns() - start) / ((double)history * DECODE_ROUNDS);
+    BENCH_CHECK(agg.count == (int)history, "agregado contou %d de %lu leituras", agg.count, (unsigned long)history);
+
+    check_timestamp_jumps();
+
+    double bits = packed_total * 8.0 / n;
+    printf("comprimido: %zu bytes em %d blocos, %.2f bits/leitura\n", packed_total, block_count, bits);
+    printf("taxa: %.1fx sobre PackedReading (8 B), %.1fx sobre SensorReading (16 B)\n",
+           64.0 / bits, 128.0 / bits);
+    printf("codificação: %.1f ns/leitura; decodificação: %.1f ns/leitura (%.1f M leituras/s)\n",
+           encode_ns, decode_ns, 1000.0 / decode_ns);
+    printf("agregado no ReadingStore: %lu leituras no histórico, %.1f ns/leitura\n",
+           (unsigned long)history, query_ns);
+    return bench_failures != 0;
+}
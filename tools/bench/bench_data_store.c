@@ -0,0 +1,66 @@
+// Custo de inserção no ReadingStore para a capacidade com que foi compilado
+// (READING_STORE_CAPACITY). O CMake gera um executável por capacidade: o custo por
+// leitura do anel deve ficar constante, enquanto o deslocamento do array usado antes
+// (memmove de todas as leituras a cada inserção) cresce com a capacidade.
+
+#include <string.h>
+#include "bench.h"
+#include "data_store.h"
+
+#define ROUNDS 4                // Voltas completas no anel medidas
+
+static ReadingStore store;
+static PackedReading legacy[MAX_READINGS];
+
+// Série sintética com variação lenta, como um dia de leituras a cada 2 s
+static void make_sample(uint32_t i, CodecSample* sample) {
+    sample->timestamp = 1000 + i * 2;
+    sample->temperature = (int16_t)(2500 + (int32_t)(i % 200) - 100);
+    sample->humidity = (uint16_t)(6000 + (i % 50));
+    sample->pressure = (uint16_t)(7133 + (i % 7));
+}
+
+int main(void) {
+    const uint32_t total = (uint32_t)MAX_READINGS * ROUNDS;
+    CodecSample sample;
+    uint32_t i = 0;
+
+    // Enche o anel primeiro: o caso caro da versão anterior era o store cheio
+    reading_store_init(&store);
+    for (; i < MAX_READINGS; i++) {
+        make_sample(i, &sample);
+        reading_store_add_sample(&store, &sample);
+    }
+
+    uint64_t start = bench_now_ns();
+    for (uint32_t n = 0; n < total; n++, i++) {
+        make_sample(i, &sample);
+        reading_store_add_sample(&store, &sample);
+    }
+    double ring_ns = (double)(bench_now_ns() - start) / total;
+
+    // Pior inserção isolada (a que sela e comprime um bloco), medida em uma volta à parte
+    uint64_t worst = 0;
+    for (uint32_t n = 0; n < MAX_READINGS; n++, i++) {
+        make_sample(i, &sample);
+        uint64_t t0 = bench_now_ns();
+        reading_store_add_sample(&store, &sample);
+        uint64_t dt = bench_now_ns() - t0;
+        if (dt > worst) worst = dt;
+    }
+
+    // Referência: deslocamento de todas as leituras a cada inserção (store cheio)
+    uint32_t legacy_total = total < 20000 ? total : 20000;
+    start = bench_now_ns();
+    for (uint32_t n = 0; n < legacy_total; n++) {
+        memmove(&legacy[0], &legacy[1], (MAX_READINGS - 1) * sizeof(legacy[0]));
+        legacy[MAX_READINGS - 1].dt = (uint16_t)n;
+    }
+    double shift_ns = (double)(bench_now_ns() - start) / legacy_total;
+    bench_consume(legacy[0].dt);
+
+    printf("capacidade %6d: anel %6.1f ns/leitura (pior %5llu ns, inclui selar bloco), "
+           "deslocamento %8.1f ns/leitura\n",
+           MAX_READINGS, ring_ns, (unsigned long long)worst, shift_ns);
+    return 0;
+}
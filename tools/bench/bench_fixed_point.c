@@ -0,0 +1,225 @@
+// Pipeline de medição em ponto fixo (user-010/011) contra o caminho antigo em float/double,
+// reproduzindo uma série fixa de leituras:
+//  - conversão do AHT20: aht20_collect atual x conversão em float de antes do ponto fixo
+//  - média das temperaturas e verificação de limites: inteiros x float
+//  - altitude: tabela interpolada (altitude_from_pressure) + limite x pow() em double
+//  - textos do display: fp_format x sprintf("%.1f")
+// O host tem FPU, então a diferença aqui subestima a do RP2040, onde todo float/double
+// passa pelas rotinas de software. Para o número no alvo, meça o mesmo laço com time_us_32.
+
+#include <math.h>
+#include "bench.h"
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "aht20.h"
+#include "altitude.h"
+#include "sensor_limits.h"
+
+#define SAMPLES  4096
+#define ROUNDS   100
+
+// Uma leitura da série: resposta crua do AHT20 e saída já compensada do BMP280
+typedef struct {
+    uint8_t aht_frame[6];
+    int32_t bmp_temp;       // centi-°C
+    int32_t pressure;       // Pa
+} ReplaySample;
+
+static ReplaySample replay[SAMPLES];
+
+// Caminho antigo (antes de user-010 e user-011) ------------------------------
+
+typedef struct {
+    float temperature;
+    float humidity;
+} OldAHT20Data;
+
+typedef struct {
+    float min_temp, max_temp;
+    float min_humidity, max_humidity;
+    float min_pressure, max_pressure;   // hPa
+    bool alert_enabled;
+} OldLimits;
+
+static const OldLimits old_limits = { 15.0f, 35.0f, 30.0f, 80.0f, 980.0f, 1030.0f, true };
+
+static bool old_aht20_collect(i2c_inst_t *i2c, OldAHT20Data *data) {
+    uint8_t buffer[6];
+    if (i2c_read_blocking(i2c, AHT20_I2C_ADDR, buffer, 6, false) != 6) return false;
+    if (buffer[0] & 0x80) return false;
+    uint32_t raw_humidity = ((uint32_t)buffer[1] << 12) | ((uint32_t)buffer[2] << 4) | (buffer[3] >> 4);
+    data->humidity = (float)raw_humidity * 100.0 / 1048576.0;
+    uint32_t raw_temp = ((uint32_t)(buffer[3] & 0x0F) << 16) | ((uint32_t)buffer[4] << 8) | buffer[5];
+    data->temperature = ((float)raw_temp * 200.0 / 1048576.0) - 50.0;
+    return true;
+}
+
+static bool old_check(const OldLimits* limits, float temperature, float humidity, float pressure) {
+    if (!limits->alert_enabled) return true;
+    return temperature >= limits->min_temp && temperature <= limits->max_temp &&
+           humidity >= limits->min_humidity && humidity <= limits->max_humidity &&
+           pressure >= limits->min_pressure && pressure <= limits->max_pressure;
+}
+
+static double old_altitude(double pressure) {
+    return 44330.0 * (1.0 - pow(pressure / 101325.0, 0.1903));
+}
+
+// ----------------------------------------------------------------------------
+
+// Série determinística: 20..30 °C, 40..70 %, 950..1040 hPa
+static void build_replay(void) {
+    for (int i = 0; i < SAMPLES; i++) {
+        uint32_t raw_hum = 419430 + (uint32_t)(i * 97) % 314573;
+        uint32_t raw_temp = 367001 + (uint32_t)(i * 53) % 52429;
+        ReplaySample* s = &replay[i];
+        s->aht_frame[0] = 0x18;
+        s->aht_frame[1] = (uint8_t)(raw_hum >> 12);
+        s->aht_frame[2] = (uint8_t)(raw_hum >> 4);
+        s->aht_frame[3] = (uint8_t)((raw_hum << 4) | (raw_temp >> 16));
+        s->aht_frame[4] = (uint8_t)(raw_temp >> 8);
+        s->aht_frame[5] = (uint8_t)raw_temp;
+        s->bmp_temp = 2000 + (i * 31) % 1000;
+        s->pressure = 95000 + (i * 173) % 9000;
+    }
+}
+
+// Resultados intermediários de cada caminho, para medir as etapas em laços separados
+static OldAHT20Data old_aht[SAMPLES];
+static float old_avg[SAMPLES];
+static double old_alt[SAMPLES];
+static AHT20_Data new_aht[SAMPLES];
+static int32_t new_avg[SAMPLES];
+static int32_t new_alt[SAMPLES];
+static bool ok[SAMPLES];
+
+static double per_sample(uint64_t start) {
+    return (double)(bench_now_ns() - start) / ((double)SAMPLES * ROUNDS);
+}
+
+int main(void) {
+    SensorLimits limits;
+    sensor_limits_init(&limits);
+    build_replay();
+
+    // Conferência: o caminho novo concorda com o antigo dentro da resolução das unidades
+    for (int i = 0; i < SAMPLES; i++) {
+        memcpy(bench_i2c_rx, replay[i].aht_frame, 6);
+        bool read_ok = aht20_collect(NULL, &new_aht[i]) == AHT20_OK;
+        read_ok = old_aht20_collect(NULL, &old_aht[i]) && read_ok;
+        BENCH_CHECK(read_ok, "leitura %d do AHT20 falhou", i);
+        BENCH_CHECK(fabs(new_aht[i].temperature / 100.0 - old_aht[i].temperature) <= 0.005 &&
+                    fabs(new_aht[i].humidity / 100.0 - old_aht[i].humidity) <= 0.005,
+                    "AHT20 %d: %ld/%ld x %.4f/%.4f", i, (long)new_aht[i].temperature, (long)new_aht[i].humidity,
+                    old_aht[i].temperature, old_aht[i].humidity);
+        double reference = old_altitude(replay[i].pressure) * 100.0;
+        int32_t altitude = altitude_from_pressure(replay[i].pressure, ALTITUDE_STANDARD_QNH);
+        BENCH_CHECK(fabs(altitude - reference) <= 4.0, "altitude %d: %ld cm x %.1f cm",
+                    i, (long)altitude, reference);
+    }
+
+    // Erro máximo documentado em altitude.h, varrendo o QNH de 950 a 1050 hPa
+    for (int32_t qnh = 95000; qnh <= 105000; qnh += 250) {
+        for (int32_t pressure = 30000; pressure <= 110000; pressure += 37) {
+            double reference = 4433000.0 * (1.0 - pow((double)pressure / qnh, 0.1903));
+            double bound = pressure >= 80000 && pressure <= 105000 ? 4.0 : 14.0;
+            int32_t altitude = altitude_from_pressure(pressure, qnh);
+            BENCH_CHECK(fabs(altitude - reference) <= bound, "altitude %ld Pa, QNH %ld: %ld cm x %.1f cm",
+                        (long)pressure, (long)qnh, (long)altitude, reference);
+        }
+    }
+
+    double old_ns[4], new_ns[4];
+    char str_tmp[16], str_umi[16], str_press[16], str_num[12];
+    uint64_t start;
+
+    // Conversão do AHT20 (inclui a leitura do stub de I2C, igual nos dois caminhos)
+    start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            memcpy(bench_i2c_rx, replay[i].aht_frame, 6);
+            old_aht20_collect(NULL, &old_aht[i]);
+        }
+    }
+    old_ns[0] = per_sample(start);
+    start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            memcpy(bench_i2c_rx, replay[i].aht_frame, 6);
+            aht20_collect(NULL, &new_aht[i]);
+        }
+    }
+    new_ns[0] = per_sample(start);
+
+    // Média das temperaturas e limites de temperatura, umidade e pressão
+    start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            old_avg[i] = (replay[i].bmp_temp / 100.0f + old_aht[i].temperature) / 2.0f;
+            ok[i] = old_check(&old_limits, old_avg[i], old_aht[i].humidity, replay[i].pressure / 100.0f);
+        }
+    }
+    old_ns[1] = per_sample(start);
+    start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            new_avg[i] = (replay[i].bmp_temp + new_aht[i].temperature) / 2;
+            ok[i] = sensor_limits_check_temperature(&limits, new_avg[i]) &&
+                    sensor_limits_check_humidity(&limits, new_aht[i].humidity) &&
+                    sensor_limits_check_pressure(&limits, replay[i].pressure);
+        }
+    }
+    new_ns[1] = per_sample(start);
+
+    // Altitude (o caminho novo também confere o limite de altitude)
+    start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            old_alt[i] = old_altitude(replay[i].pressure);
+        }
+    }
+    old_ns[2] = per_sample(start);
+    start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            new_alt[i] = altitude_from_pressure(replay[i].pressure, limits.sea_level_pressure);
+            ok[i] = sensor_limits_check_altitude(&limits, new_alt[i]);
+        }
+    }
+    new_ns[2] = per_sample(start);
+
+    // Textos do display
+    start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            sprintf(str_tmp, "%.1fC", old_avg[i]);
+            sprintf(str_umi, "%.1f%%", old_aht[i].humidity);
+            sprintf(str_press, "%.1f", replay[i].pressure / 1000.0);
+            bench_consume((uint8_t)str_tmp[0] + (uint8_t)str_umi[0] + (uint8_t)str_press[0]);
+        }
+    }
+    old_ns[3] = per_sample(start);
+    start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            snprintf(str_tmp, sizeof(str_tmp), "%sC", fp_format(str_num, sizeof(str_num), new_avg[i], 2, 1));
+            snprintf(str_umi, sizeof(str_umi), "%s%%", fp_format(str_num, sizeof(str_num), new_aht[i].humidity, 2, 1));
+            fp_format(str_press, sizeof(str_press), replay[i].pressure, 3, 1);
+            bench_consume((uint8_t)str_tmp[0] + (uint8_t)str_umi[0] + (uint8_t)str_press[0]);
+        }
+    }
+    new_ns[3] = per_sample(start);
+    bench_consume(ok[SAMPLES - 1] + (uint32_t)old_alt[SAMPLES - 1] + (uint32_t)new_alt[SAMPLES - 1]);
+
+    static const char* const stage[4] = { "conversão AHT20", "média + limites", "altitude", "textos do display" };
+    double old_total = 0, new_total = 0;
+    for (int k = 0; k < 4; k++) {
+        old_total += old_ns[k];
+        new_total += new_ns[k];
+        printf("%-18s float %7.1f ns  ponto fixo %7.1f ns  (%.2fx)\n", stage[k], old_ns[k], new_ns[k],
+               old_ns[k] / new_ns[k]);
+    }
+    printf("%-18s float %7.1f ns  ponto fixo %7.1f ns  (%.2fx)\n", "total por ciclo", old_total, new_total,
+           old_total / new_total);
+    return bench_failures != 0;
+}
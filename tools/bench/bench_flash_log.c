@@ -0,0 +1,323 @@
+// Log de leituras em flash (flash_log.c) no host.
+// Testes sobre o backend de arquivo (FLASH_LOG_HOST), reiniciando com flash_log_init sobre
+// o mesmo conteúdo:
+//  - anexar + flush e o que sobrevive a um reinício
+//  - recuperação da página livre (busca binária) com 0..15 páginas gravadas
+//  - rodízio de setores depois de várias voltas
+//  - rodízio atravessando o estouro da sequência de 32 bits
+//  - página rasgada por queda de energia e registro com CRC inválido
+// Benchmark sobre uma flash em RAM com a mesma semântica (gravar só leva bits de 1 a 0),
+// para medir o custo de CPU sem o sistema de arquivos: anexar, recuperar e percorrer.
+//
+// Uso: bench_flash_log [arquivo]   (padrão: flash_log_test.bin no diretório atual)
+
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "flash_log.h"
+
+#define TEST_SECTORS        4
+#define TEST_SIZE           (TEST_SECTORS * FLASH_LOG_SECTOR_SIZE)
+#define RECORDS_PER_SECTOR  ((FLASH_LOG_PAGES_PER_SECTOR - 1) * FLASH_LOG_RECORDS_PER_PAGE)
+
+static const char* path = "flash_log_test.bin";
+
+// Backend intermediário: conta operações e simula queda de energia no meio de uma gravação
+typedef struct {
+    FlashLogIO base;
+    uint32_t reads, programs, erases;
+    int tear_bytes;         // >= 0: a próxima gravação de página só grava esses bytes e a energia cai
+    bool powered_off;       // Depois da queda, toda operação falha
+} TestIO;
+
+static bool test_read(void* ctx, uint32_t offset, void* dst, size_t len) {
+    TestIO* t = ctx;
+    t->reads++;
+    return !t->powered_off && t->base.read(t->base.ctx, offset, dst, len);
+}
+
+static bool test_erase(void* ctx, uint32_t offset) {
+    TestIO* t = ctx;
+    t->erases++;
+    return !t->powered_off && t->base.erase_sector(t->base.ctx, offset);
+}
+
+static bool test_program(void* ctx, uint32_t offset, const uint8_t* page) {
+    TestIO* t = ctx;
+    if (t->powered_off) return false;
+    t->programs++;
+    if (t->tear_bytes >= 0) {
+        uint8_t partial[FLASH_LOG_PAGE_SIZE];
+        memset(partial, 0xFF, sizeof(partial));
+        memcpy(partial, page, (size_t)t->tear_bytes);
+        t->base.program_page(t->base.ctx, offset, partial);
+        t->powered_off = true;
+        return false;
+    }
+    return t->base.program_page(t->base.ctx, offset, page);
+}
+
+static FlashLogIO test_io(TestIO* t, const FlashLogIO* base) {
+    memset(t, 0, sizeof(*t));
+    t->base = *base;
+    t->tear_bytes = -1;
+    return (FlashLogIO){ test_read, test_erase, test_program, t };
+}
+
+// Região nova, toda apagada
+static FlashLogIO fresh_file(void) {
+    FlashLogIO io;
+    remove(path);
+    if (!flash_log_file_io(&io, path, TEST_SIZE)) {
+        printf("não foi possível criar %s\n", path);
+        exit(1);
+    }
+    return io;
+}
+
+static void append_range(FlashLog* log, uint32_t first, uint32_t count) {
+    for (uint32_t ts = first; ts < first + count; ts++) {
+        flash_log_append(log, ts, (int16_t)(ts * 3), (uint16_t)(ts * 5), (uint16_t)(ts * 7));
+    }
+}
+
+// Percorre o log: confere o conteúdo de cada registro, conta e devolve o primeiro/último timestamp.
+// Com 'consecutive', exige timestamps sem lacunas
+static uint32_t walk(const FlashLog* log, bool consecutive, uint32_t* first, uint32_t* last) {
+    FlashLogIter it;
+    FlashLogRecord rec;
+    uint32_t count = 0;
+    flash_log_iter_begin(log, &it);
+    while (flash_log_iter_next(&it, &rec)) {
+        BENCH_CHECK(rec.temperature == (int16_t)(rec.timestamp * 3) && rec.humidity == (uint16_t)(rec.timestamp * 5) &&
+                    rec.pressure == (uint16_t)(rec.timestamp * 7), "registro %lu corrompido", (unsigned long)rec.timestamp);
+        if (count == 0) {
+            *first = rec.timestamp;
+        } else if (consecutive) {
+            BENCH_CHECK(rec.timestamp == *last + 1, "lacuna: %lu depois de %lu",
+                        (unsigned long)rec.timestamp, (unsigned long)*last);
+        }
+        *last = rec.timestamp;
+        count++;
+    }
+    return count;
+}
+
+static void test_append_flush(void) {
+    FlashLogIO io = fresh_file();
+    FlashLog log, rebooted;
+    uint32_t first = 0, last = 0;
+
+    flash_log_init(&log, &io, TEST_SIZE);
+    append_range(&log, 1, 5);
+    BENCH_CHECK(flash_log_flush(&log), "flush falhou");
+    append_range(&log, 6, 3);
+    BENCH_CHECK(flash_log_flush(&log), "flush falhou");
+    BENCH_CHECK(walk(&log, true, &first, &last) == 8, "antes do reinício");
+
+    // Cada flush fecha a página: páginas 1 e 2 gravadas
+    flash_log_init(&rebooted, &io, TEST_SIZE);
+    BENCH_CHECK(rebooted.head_page == 3, "head_page %lu, esperado 3", (unsigned long)rebooted.head_page);
+    BENCH_CHECK(walk(&rebooted, true, &first, &last) == 8 && first == 1 && last == 8, "depois do reinício");
+    BENCH_CHECK(rebooted.last_timestamp == 8, "last_timestamp %lu", (unsigned long)rebooted.last_timestamp);
+
+    // O que estava só no buffer de página se perde no reinício
+    append_range(&rebooted, 9, 4);
+    flash_log_init(&rebooted, &io, TEST_SIZE);
+    BENCH_CHECK(walk(&rebooted, true, &first, &last) == 8, "registros sem flush sobreviveram");
+}
+
+static void test_recovery(void) {
+    for (uint32_t pages = 0; pages < FLASH_LOG_PAGES_PER_SECTOR; pages++) {
+        FlashLogIO io = fresh_file();
+        FlashLog log;
+        uint32_t first = 0, last = 0;
+        uint32_t records = pages * FLASH_LOG_RECORDS_PER_PAGE;
+
+        flash_log_init(&log, &io, TEST_SIZE);
+        append_range(&log, 1, records);      // Páginas cheias são gravadas sozinhas
+
+        TestIO counter;
+        FlashLogIO counted = test_io(&counter, &io);
+        flash_log_init(&log, &counted, TEST_SIZE);
+        if (pages == 0) {
+            BENCH_CHECK(log.sequence == 0, "região vazia com sequência %lu", (unsigned long)log.sequence);
+            continue;
+        }
+        BENCH_CHECK(log.head_page == 1 + pages, "%lu páginas: head_page %lu", (unsigned long)pages,
+                    (unsigned long)log.head_page);
+        BENCH_CHECK(walk(&log, true, &first, &last) == records && last == records,
+                    "%lu páginas: registros recuperados", (unsigned long)pages);
+        BENCH_CHECK(log.last_timestamp == records, "%lu páginas: last_timestamp %lu", (unsigned long)pages,
+                    (unsigned long)log.last_timestamp);
+    }
+}
+
+// Depois de várias voltas: o setor mais antigo é sobrescrito e o resto continua em ordem
+static void check_rotation(FlashLog* log, const FlashLogIO* io, uint32_t first_ts, uint32_t total) {
+    uint32_t first = 0, last = 0;
+    flash_log_init(log, io, TEST_SIZE);
+    uint32_t head_records = (log->head_page - 1) * FLASH_LOG_RECORDS_PER_PAGE;
+    uint32_t expected = (TEST_SECTORS - 1) * RECORDS_PER_SECTOR + head_records;
+    uint32_t count = walk(log, true, &first, &last);
+    BENCH_CHECK(count == expected, "rodízio: %lu registros, esperado %lu", (unsigned long)count,
+                (unsigned long)expected);
+    BENCH_CHECK(last == first_ts + total - 1 && first == last - count + 1, "rodízio: faixa %lu..%lu",
+                (unsigned long)first, (unsigned long)last);
+    BENCH_CHECK(log->last_timestamp == last, "rodízio: last_timestamp %lu", (unsigned long)log->last_timestamp);
+}
+
+static void test_rotation(void) {
+    FlashLogIO io = fresh_file();
+    FlashLog log;
+    uint32_t total = 5 * RECORDS_PER_SECTOR + 3 * FLASH_LOG_RECORDS_PER_PAGE;
+    flash_log_init(&log, &io, TEST_SIZE);
+    append_range(&log, 1, total);
+    BENCH_CHECK(log.sequence == 6, "sequência %lu após 6 setores abertos", (unsigned long)log.sequence);
+    check_rotation(&log, &io, 1, total);
+    BENCH_CHECK(log.head_sector == 5 % TEST_SECTORS, "head_sector %lu", (unsigned long)log.head_sector);
+}
+
+static void test_sequence_wrap(void) {
+    FlashLogIO io = fresh_file();
+    FlashLog log;
+    flash_log_init(&log, &io, TEST_SIZE);
+
+    // Semeia a sequência perto do limite, com o último setor "cheio": o próximo flush abre
+    // o setor 0 com 0xFFFFFFF9, e as onze aberturas (dez setores cheios + um parcial) passam
+    // por 0xFFFFFFFF -> 1
+    log.sequence = 0xFFFFFFF8u;
+    log.head_sector = TEST_SECTORS - 1;
+    log.head_page = FLASH_LOG_PAGES_PER_SECTOR;
+    uint32_t total = 10 * RECORDS_PER_SECTOR + 2 * FLASH_LOG_RECORDS_PER_PAGE;
+    append_range(&log, 1000, total);
+    uint32_t sequence = log.sequence, head = log.head_sector;
+    BENCH_CHECK(sequence == 4, "sequência %lu após o estouro (0 é pulado)", (unsigned long)sequence);
+
+    check_rotation(&log, &io, 1000, total);
+    BENCH_CHECK(log.sequence == sequence && log.head_sector == head, "estouro: cabeça %lu/%lu, esperado %lu/%lu",
+                (unsigned long)log.head_sector, (unsigned long)log.sequence, (unsigned long)head,
+                (unsigned long)sequence);
+
+    // Continua anexando depois do reinício
+    append_range(&log, 1000 + total, RECORDS_PER_SECTOR);
+    check_rotation(&log, &io, 1000, total + RECORDS_PER_SECTOR);
+}
+
+static void test_torn_page_and_bad_crc(void) {
+    FlashLogIO io = fresh_file();
+    FlashLog log;
+    uint32_t first = 0, last = 0;
+    uint32_t full = 2 * FLASH_LOG_RECORDS_PER_PAGE;
+
+    flash_log_init(&log, &io, TEST_SIZE);
+    append_range(&log, 1, full);
+
+    // Queda de energia com só 100 bytes da terceira página gravados: 8 registros inteiros
+    // e o 9º cortado no meio (CRC inválido)
+    TestIO torn;
+    FlashLogIO torn_io = test_io(&torn, &io);
+    flash_log_init(&log, &torn_io, TEST_SIZE);
+    torn.tear_bytes = 100;
+    append_range(&log, full + 1, FLASH_LOG_RECORDS_PER_PAGE);
+    BENCH_CHECK(torn.powered_off, "a gravação da página não foi interrompida");
+
+    uint32_t survived = 100 / FLASH_LOG_RECORD_SIZE;
+    flash_log_init(&log, &io, TEST_SIZE);
+    BENCH_CHECK(log.head_page == 4, "página rasgada: head_page %lu, esperado 4", (unsigned long)log.head_page);
+    BENCH_CHECK(walk(&log, true, &first, &last) == full + survived && last == full + survived,
+                "página rasgada: %lu..%lu", (unsigned long)first, (unsigned long)last);
+    BENCH_CHECK(log.last_timestamp == full + survived, "página rasgada: last_timestamp %lu",
+                (unsigned long)log.last_timestamp);
+
+    // A gravação continua na página seguinte
+    append_range(&log, last + 1, 5);
+    flash_log_flush(&log);
+    flash_log_init(&log, &io, TEST_SIZE);
+    BENCH_CHECK(walk(&log, true, &first, &last) == full + survived + 5, "depois da página rasgada");
+
+    // Um bit apagado no timestamp do registro 4 (gravar só leva 1 -> 0): CRC inválido, o registro é pulado
+    uint8_t page[FLASH_LOG_PAGE_SIZE];
+    uint32_t page_offset = log.head_sector * FLASH_LOG_SECTOR_SIZE + 1 * FLASH_LOG_PAGE_SIZE;
+    io.read(io.ctx, page_offset, page, sizeof(page));
+    uint8_t* byte = &page[3 * FLASH_LOG_RECORD_SIZE];
+    *byte &= (uint8_t)(*byte - 1);       // Apaga o bit 1 mais baixo
+    io.program_page(io.ctx, page_offset, page);
+    flash_log_init(&log, &io, TEST_SIZE);
+    uint32_t count = walk(&log, false, &first, &last);
+    BENCH_CHECK(count == full + survived + 4 && first == 1 && last == full + survived + 5,
+                "CRC inválido: %lu registros (%lu..%lu)", (unsigned long)count, (unsigned long)first,
+                (unsigned long)last);
+}
+
+// Benchmark -----------------------------------------------------------------------------
+
+static uint8_t ram_flash[FLASH_LOG_SIZE];
+
+static bool ram_read(void* ctx, uint32_t offset, void* dst, size_t len) {
+    (void)ctx;
+    memcpy(dst, &ram_flash[offset], len);
+    return true;
+}
+
+static bool ram_erase(void* ctx, uint32_t offset) {
+    (void)ctx;
+    memset(&ram_flash[offset], 0xFF, FLASH_LOG_SECTOR_SIZE);
+    return true;
+}
+
+static bool ram_program(void* ctx, uint32_t offset, const uint8_t* page) {
+    (void)ctx;
+    for (uint32_t i = 0; i < FLASH_LOG_PAGE_SIZE; i++) {
+        ram_flash[offset + i] &= page[i];
+    }
+    return true;
+}
+
+static void benchmark(void) {
+    const FlashLogIO ram = { ram_read, ram_erase, ram_program, NULL };
+    TestIO counter;
+    FlashLogIO io = test_io(&counter, &ram);
+    FlashLog log;
+    uint32_t first = 0, last = 0;
+    uint32_t sectors = FLASH_LOG_SIZE / FLASH_LOG_SECTOR_SIZE;
+    uint32_t total = 3 * sectors * RECORDS_PER_SECTOR + RECORDS_PER_SECTOR / 2;   // Três voltas e meio setor
+
+    memset(ram_flash, 0xFF, sizeof(ram_flash));
+    flash_log_init(&log, &io, FLASH_LOG_SIZE);
+    uint64_t start = bench_now_ns();
+    append_range(&log, 1, total);
+    double append_ns = (double)(bench_now_ns() - start) / total;
+    uint32_t programs = counter.programs, erases = counter.erases;
+
+    counter.reads = 0;
+    start = bench_now_ns();
+    flash_log_init(&log, &io, FLASH_LOG_SIZE);
+    double init_us = (double)(bench_now_ns() - start) / 1000.0;
+    uint32_t init_reads = counter.reads;
+
+    start = bench_now_ns();
+    uint32_t count = walk(&log, true, &first, &last);
+    double walk_ns = (double)(bench_now_ns() - start) / count;
+
+    printf("anexar: %.1f ns/registro; %lu páginas gravadas e %lu setores apagados em %lu registros\n",
+           append_ns, (unsigned long)programs, (unsigned long)erases, (unsigned long)total);
+    printf("recuperar (%lu setores): %.1f us, %lu leituras\n", (unsigned long)sectors, init_us,
+           (unsigned long)init_reads);
+    printf("percorrer: %lu registros, %.1f ns/registro (com CRC)\n", (unsigned long)count, walk_ns);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) path = argv[1];
+
+    test_append_flush();
+    test_recovery();
+    test_rotation();
+    test_sequence_wrap();
+    test_torn_page_and_bad_crc();
+    remove(path);
+    printf("testes: %s\n", bench_failures == 0 ? "ok" : "FALHARAM");
+
+    benchmark();
+    return bench_failures != 0;
+}
@@ -0,0 +1,245 @@
+// Atualização do painel: /api/snapshot (uma requisição) x as cinco requisições de antes
+// (/temperature, /humidity, /atm_pressure, /limits e /sensor_status).
+// Cada requisição passa pelo mesmo caminho de http_build_response: leitura dos cabeçalhos
+// (http_request.c), ETag, corpo JSON (station_json.h) e cabeçalho da resposta. As
+// requisições levam cabeçalhos típicos do Chrome numa conexão keep-alive; cada atualização
+// traz uma leitura nova, então nenhuma resposta é 304.
+// Também confere que o snapshot traz os mesmos valores das rotas separadas e cabe nos
+// buffers da rota (json_payload e o slot da conexão).
+
+#include <math.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "http_request.h"
+#include "station_json.h"
+
+#define REFRESHES           2000
+#define SNAPSHOT_JSON_SIZE  896     // json_payload da rota /api/snapshot
+#define RESPONSE_SIZE       1536    // HTTP_RESPONSE_SIZE (http_conn.h)
+
+SensorLimits sensor_limits;
+
+// Igual a alert_severity em SE_Meteorological_Station.c
+static AlertSeverity severity_of(const LimitCheckResult* check) {
+    int failing = !check->temperature_ok + !check->humidity_ok + !check->pressure_ok + !check->altitude_ok;
+    if (failing >= 2) return ALERT_CRITICAL;
+    if (failing == 1) return ALERT_WARNING;
+    return ALERT_NONE;
+}
+
+typedef enum { ROUTE_TEMPERATURE, ROUTE_HUMIDITY, ROUTE_PRESSURE, ROUTE_LIMITS, ROUTE_STATUS, ROUTE_SNAPSHOT } Route;
+
+static const char* const route_paths[] = {
+    "/temperature", "/humidity", "/atm_pressure", "/limits", "/sensor_status", "/api/snapshot"
+};
+
+static char requests[6][640];
+static size_t request_lens[6];
+
+static void build_requests(void) {
+    for (int r = 0; r <= ROUTE_SNAPSHOT; r++) {
+        request_lens[r] = (size_t)snprintf(requests[r], sizeof(requests[r]),
+            "GET %s HTTP/1.1\r\n"
+            "Host: 192.168.0.50\r\n"
+            "Connection: keep-alive\r\n"
+            "User-Agent: Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 "
+            "(KHTML, like Gecko) Chrome/126.0.0.0 Safari/537.36\r\n"
+            "Accept: */*\r\n"
+            "Referer: http://192.168.0.50/\r\n"
+            "Accept-Encoding: gzip, deflate\r\n"
+            "Accept-Language: pt-BR,pt;q=0.9,en-US;q=0.8,en;q=0.7\r\n"
+            "\r\n", route_paths[r]);
+    }
+}
+
+// Uma leitura como a publicada no StationSnapshot (ponto fixo + decodificada)
+typedef struct {
+    uint32_t sequence;
+    int32_t temperature, humidity, pressure;    // centi-°C, centi-%, Pa
+    SensorReading last;
+} Reading;
+
+static Reading reading_at(uint32_t i) {
+    Reading r;
+    r.sequence = i + 1;
+    r.temperature = 2000 + (int32_t)(i * 37 % 1000);
+    r.humidity = 4000 + (int32_t)(i * 53 % 3000);
+    r.pressure = 97000 + (int32_t)(i * 71 % 7000);
+    r.last.temperature = r.temperature / 100.0f;
+    r.last.humidity = r.humidity / 100.0f;
+    r.last.pressure = r.pressure / 100.0f;
+    r.last.timestamp = i;
+    return r;
+}
+
+// Uma requisição atendida como em http_build_response; retorna os bytes da resposta
+static size_t serve(Route route, const Reading* reading, char* json_payload, size_t json_size, char* response) {
+    const char* req = requests[route];
+    size_t req_len = request_lens[route];
+    BENCH_CHECK(http_request_length(req, req_len) == req_len, "requisição %s incompleta", route_paths[route]);
+    const char* connection = http_keep_alive(req, req_len) ? "Connection: keep-alive\r\n\r\n"
+                                                          : "Connection: close\r\n\r\n";
+    char data_etag[40];
+    snprintf(data_etag, sizeof(data_etag), "W/\"%08lx-%lu-%lu\"", 0x1234abcdUL, (unsigned long)reading->sequence, 0UL);
+    if (http_etag_matches(req, req_len, data_etag)) return 0;
+
+    const SensorReading* last = &reading->last;
+    int32_t altitude = 0;
+    LimitCheckResult check;
+    int json_len = 0;
+    switch (route) {
+    case ROUTE_TEMPERATURE:
+        json_len = station_json_value(json_payload, json_size, last->temperature, "°C", last->timestamp);
+        break;
+    case ROUTE_HUMIDITY:
+        json_len = station_json_value(json_payload, json_size, last->humidity, "%", last->timestamp);
+        break;
+    case ROUTE_PRESSURE:
+        json_len = station_json_value(json_payload, json_size, last->pressure, "hPa", last->timestamp);
+        break;
+    case ROUTE_LIMITS:
+        json_len = station_json_limits(json_payload, json_size, &sensor_limits);
+        break;
+    case ROUTE_STATUS:
+    case ROUTE_SNAPSHOT:
+        altitude = altitude_from_pressure(reading->pressure, sensor_limits.sea_level_pressure);
+        check = sensor_limits_check_all(&sensor_limits, reading->temperature, reading->humidity,
+                                        reading->pressure, altitude);
+        json_len = route == ROUTE_STATUS
+            ? station_json_status(json_payload, json_size, last, altitude, &check, last->timestamp)
+            : station_json_snapshot(json_payload, json_size, reading->sequence, last, altitude, &sensor_limits,
+                                    &check, severity_of(&check));
+        break;
+    }
+    int len = snprintf(response, RESPONSE_SIZE,
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: %d\r\n"
+        "ETag: %s\r\n"
+        "Cache-Control: no-cache\r\n"
+        "%s%s",
+        json_len, data_etag, connection, json_payload);
+    return (size_t)len;
+}
+
+// Número depois de "key": (com ou sem espaço) no JSON; NAN se não existir
+static double json_number(const char* json, const char* key) {
+    char pattern[40];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char* p = strstr(json, pattern);
+    return p ? strtod(p + strlen(pattern), NULL) : NAN;
+}
+
+// O snapshot traz os mesmos valores das rotas separadas
+static void check_snapshot(const Reading* reading) {
+    char snapshot[SNAPSHOT_JSON_SIZE], route[768], response[RESPONSE_SIZE];
+
+    serve(ROUTE_SNAPSHOT, reading, snapshot, sizeof(snapshot), response);
+    const char* snap_reading = strstr(snapshot, "\"reading\":");
+    const char* snap_limits = strstr(snapshot, "\"limits\":");
+    const char* snap_status = strstr(snapshot, "\"status\":");
+    BENCH_CHECK(snap_reading && snap_limits && snap_status, "snapshot incompleto: %s", snapshot);
+    if (!snap_reading || !snap_limits || !snap_status) return;
+
+    static const char* const value_keys[] = { "temperature", "humidity", "pressure" };
+    for (int r = ROUTE_TEMPERATURE; r <= ROUTE_PRESSURE; r++) {
+        serve((Route)r, reading, route, sizeof(route), response);
+        BENCH_CHECK(json_number(route, "value") == json_number(snap_reading, value_keys[r]),
+                    "%s: %s x %s", route_paths[r], route, snapshot);
+    }
+
+    static const char* const limit_keys[] = {
+        "min_temp", "max_temp", "min_hum", "max_hum", "min_press", "max_press", "min_alt", "max_alt", "qnh"
+    };
+    serve(ROUTE_LIMITS, reading, route, sizeof(route), response);
+    for (size_t k = 0; k < sizeof(limit_keys) / sizeof(limit_keys[0]); k++) {
+        BENCH_CHECK(json_number(route, limit_keys[k]) == json_number(snap_limits, limit_keys[k]),
+                    "/limits %s: %s x %s", limit_keys[k], route, snapshot);
+    }
+
+    // /sensor_status: {"temperature": {"value": v, "ok": b}, ...} x "status":{"temperature":b,...}
+    serve(ROUTE_STATUS, reading, route, sizeof(route), response);
+    static const char* const status_keys[] = { "temperature", "humidity", "pressure", "altitude" };
+    for (int k = 0; k < 4; k++) {
+        char pattern[40];
+        snprintf(pattern, sizeof(pattern), "\"%s\": {\"value\": ", status_keys[k]);
+        const char* item = strstr(route, pattern);
+        BENCH_CHECK(item != NULL, "/sensor_status sem %s", status_keys[k]);
+        if (!item) continue;
+        bool route_ok = strncmp(strstr(item, "\"ok\": ") + 6, "true", 4) == 0;
+        snprintf(pattern, sizeof(pattern), "\"%s\":", status_keys[k]);
+        bool snap_ok = strncmp(strstr(snap_status, pattern) + strlen(pattern), "true", 4) == 0;
+        BENCH_CHECK(route_ok == snap_ok, "estado de %s: %s x %s", status_keys[k], route, snapshot);
+        BENCH_CHECK(strtod(item + strlen(pattern) + 11, NULL) == json_number(snap_reading, status_keys[k]),
+                    "valor de %s: %s x %s", status_keys[k], route, snapshot);
+    }
+    BENCH_CHECK((strstr(route, "\"all_ok\": true") != NULL) == (strstr(snap_status, "\"all_ok\":true") != NULL),
+                "all_ok: %s x %s", route, snapshot);
+}
+
+int main(void) {
+    sensor_limits_init(&sensor_limits);
+    build_requests();
+
+    // Antes da primeira leitura: reading e status null, alerta sem severidade
+    char snapshot[SNAPSHOT_JSON_SIZE];
+    int len = station_json_snapshot(snapshot, sizeof(snapshot), 0, NULL, 0, &sensor_limits, NULL, ALERT_CRITICAL);
+    const char* expected_empty =
+        "{\"seq\":0,\"reading\":null,\"limits\":{\"min_temp\":15.0,\"max_temp\":35.0,\"min_hum\":30.0,"
+        "\"max_hum\":80.0,\"min_press\":980.0,\"max_press\":1030.0,\"min_alt\":-100.0,\"max_alt\":1000.0,"
+        "\"qnh\":1013.25},\"status\":null,\"alert\":{\"enabled\":true,\"severity\":\"none\",\"message\":\"\"}}";
+    BENCH_CHECK(len == (int)strlen(expected_empty) && strcmp(snapshot, expected_empty) == 0,
+                "snapshot sem leitura: %s", snapshot);
+
+    // Mesmos valores das rotas separadas, dentro e fora dos limites
+    for (uint32_t i = 0; i < 200; i++) {
+        Reading reading = reading_at(i * 17);
+        check_snapshot(&reading);
+    }
+
+    // Pior caso (as quatro grandezas fora dos limites, mensagem mais longa) cabe nos buffers
+    Reading worst = reading_at(0);
+    worst.temperature = -4000;
+    worst.humidity = 10000;
+    worst.pressure = 30000;
+    worst.last.temperature = -40.0f;
+    worst.last.humidity = 100.0f;
+    worst.last.pressure = 300.0f;
+    char response[RESPONSE_SIZE];
+    char big[4096];
+    serve(ROUTE_SNAPSHOT, &worst, big, sizeof(big), response);
+    BENCH_CHECK(strlen(big) < SNAPSHOT_JSON_SIZE, "snapshot com %zu bytes não cabe em %d", strlen(big),
+                SNAPSHOT_JSON_SIZE);
+    BENCH_CHECK(strstr(big, "\"severity\":\"critical\"") != NULL, "severidade do pior caso: %s", big);
+    size_t worst_response = serve(ROUTE_SNAPSHOT, &worst, snapshot, sizeof(snapshot), response);
+    BENCH_CHECK(worst_response < RESPONSE_SIZE, "resposta com %zu bytes não cabe no slot", worst_response);
+
+    // Medição: REFRESHES atualizações do painel por cada caminho
+    char json_payload[768];
+    size_t old_requested = 0, old_answered = 0, new_requested = 0, new_answered = 0;
+    uint64_t start = bench_now_ns();
+    for (uint32_t i = 0; i < REFRESHES; i++) {
+        Reading reading = reading_at(i);
+        for (int r = ROUTE_TEMPERATURE; r <= ROUTE_STATUS; r++) {
+            old_answered += serve((Route)r, &reading, json_payload, sizeof(json_payload), response);
+            old_requested += request_lens[r];
+            bench_consume((uint8_t)response[old_answered % 64]);
+        }
+    }
+    double old_us = (double)(bench_now_ns() - start) / REFRESHES / 1000.0;
+
+    start = bench_now_ns();
+    for (uint32_t i = 0; i < REFRESHES; i++) {
+        Reading reading = reading_at(i);
+        new_answered += serve(ROUTE_SNAPSHOT, &reading, snapshot, sizeof(snapshot), response);
+        new_requested += request_lens[ROUTE_SNAPSHOT];
+        bench_consume((uint8_t)response[new_answered % 64]);
+    }
+    double new_us = (double)(bench_now_ns() - start) / REFRESHES / 1000.0;
+
+    printf("5 requisições: %5.0f B pedidos, %5.0f B respondidos, %.2f us por atualização\n",
+           (double)old_requested / REFRESHES, (double)old_answered / REFRESHES, old_us);
+    printf("/api/snapshot: %5.0f B pedidos, %5.0f B respondidos, %.2f us por atualização (%.1fx)\n",
+           (double)new_requested / REFRESHES, (double)new_answered / REFRESHES, new_us, old_us / new_us);
+    return bench_failures != 0;
+}
@@ -0,0 +1,174 @@
+// Redesenho completo da tela principal do SSD1306 (a mesma sequência da display_task):
+// primitivas atuais em bytes de página (ssd1306.c) x versão antiga pixel a pixel, com
+// conferência de que os dois framebuffers saem idênticos. Também mede a montagem do envio
+// das janelas alteradas (ssd1306_begin_flush, com o DMA e a I2C simulados).
+
+#include "bench.h"
+#include "ssd1306.h"
+#include "font.h"
+
+#define FRAMES  20000
+
+// Versão antiga (antes de user-013): tudo passa por ssd1306_pixel ---------------
+
+static void old_fill(ssd1306_t *ssd, bool value) {
+  for (uint8_t y = 0; y < ssd->height; ++y) {
+    for (uint8_t x = 0; x < ssd->width; ++x) {
+      ssd1306_pixel(ssd, x, y, value);
+    }
+  }
+}
+
+static void old_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  for (uint8_t x = left; x < left + width; ++x) {
+    ssd1306_pixel(ssd, x, top, value);
+    ssd1306_pixel(ssd, x, top + height - 1, value);
+  }
+  for (uint8_t y = top; y < top + height; ++y) {
+    ssd1306_pixel(ssd, left, y, value);
+    ssd1306_pixel(ssd, left + width - 1, y, value);
+  }
+  if (fill) {
+    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
+      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
+        ssd1306_pixel(ssd, x, y, value);
+      }
+    }
+  }
+}
+
+static void old_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
+  int dx = abs(x1 - x0);
+  int dy = abs(y1 - y0);
+  int sx = (x0 < x1) ? 1 : -1;
+  int sy = (y0 < y1) ? 1 : -1;
+  int err = dx - dy;
+  while (true) {
+    ssd1306_pixel(ssd, x0, y0, value);
+    if (x0 == x1 && y0 == y1) break;
+    int e2 = err * 2;
+    if (e2 > -dy) {
+      err -= dy;
+      x0 += sx;
+    }
+    if (e2 < dx) {
+      err += dx;
+      y0 += sy;
+    }
+  }
+}
+
+static void old_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
+  uint16_t index = (c >= ' ' && c <= '~') ? (c - ' ') * 8 : 0;
+  for (uint8_t i = 0; i < 8; ++i) {
+    uint8_t line = font[index + i];
+    for (uint8_t j = 0; j < 8; ++j) {
+      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
+    }
+  }
+}
+
+static void old_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y) {
+  while (*str) {
+    old_draw_char(ssd, *str++, x, y);
+    x += 8;
+    if (x + 8 >= ssd->width) {
+      x = 0;
+      y += 8;
+    }
+    if (y + 8 >= ssd->height) {
+      break;
+    }
+  }
+}
+
+// -------------------------------------------------------------------------------
+
+// Textos de uma leitura, variando como no uso real
+static void frame_strings(int frame, char *str_tmp, char *str_press, char *str_umi) {
+  snprintf(str_tmp, 8, "%d.%dC", 20 + frame % 10, frame % 7);
+  snprintf(str_press, 8, "%d.%d", 99 + frame % 3, (frame / 3) % 10);
+  snprintf(str_umi, 8, "%d.%d%%", 40 + frame % 30, frame % 9);
+}
+
+static void old_redraw(ssd1306_t *ssd, bool cor, const char *str_tmp, const char *str_press, const char *str_umi) {
+  old_fill(ssd, !cor);
+  old_rect(ssd, 3, 3, 122, 60, cor, !cor);
+  old_line(ssd, 3, 25, 123, 25, cor);
+  old_line(ssd, 3, 37, 123, 37, cor);
+  old_draw_string(ssd, "Estacao", 8, 8);
+  old_draw_string(ssd, "Meteorologica", 8, 16);
+  old_draw_string(ssd, "BMP280  AHT20", 10, 28);
+  old_line(ssd, 63, 25, 63, 60, cor);
+  old_draw_string(ssd, str_tmp, 14, 41);
+  old_draw_string(ssd, str_press, 14, 52);
+  old_draw_string(ssd, str_umi, 73, 45);
+}
+
+static void new_redraw(ssd1306_t *ssd, bool cor, const char *str_tmp, const char *str_press, const char *str_umi) {
+  ssd1306_fill(ssd, !cor);
+  ssd1306_rect(ssd, 3, 3, 122, 60, cor, !cor);
+  ssd1306_line(ssd, 3, 25, 123, 25, cor);
+  ssd1306_line(ssd, 3, 37, 123, 37, cor);
+  ssd1306_draw_string(ssd, "Estacao", 8, 8);
+  ssd1306_draw_string(ssd, "Meteorologica", 8, 16);
+  ssd1306_draw_string(ssd, "BMP280  AHT20", 10, 28);
+  ssd1306_line(ssd, 63, 25, 63, 60, cor);
+  ssd1306_draw_string(ssd, str_tmp, 14, 41);
+  ssd1306_draw_string(ssd, str_press, 14, 52);
+  ssd1306_draw_string(ssd, str_umi, 73, 45);
+}
+
+int main(void) {
+  ssd1306_t old_ssd, new_ssd;
+  ssd1306_init(&old_ssd, WIDTH, HEIGHT, false, 0x3C, NULL);
+  ssd1306_init(&new_ssd, WIDTH, HEIGHT, false, 0x3C, NULL);
+  char str_tmp[8], str_press[8], str_umi[8];
+
+  // Conferência: quadros idênticos nas duas cores e em vários textos
+  for (int frame = 0; frame < 64; frame++) {
+    bool cor = frame % 2 == 0;
+    frame_strings(frame, str_tmp, str_press, str_umi);
+    old_redraw(&old_ssd, cor, str_tmp, str_press, str_umi);
+    new_redraw(&new_ssd, cor, str_tmp, str_press, str_umi);
+    BENCH_CHECK(memcmp(old_ssd.ram_buffer, new_ssd.ram_buffer, new_ssd.bufsize) == 0,
+                "quadro %d (cor %d) difere da versão pixel a pixel", frame, cor);
+  }
+
+  uint64_t start = bench_now_ns();
+  for (int frame = 0; frame < FRAMES; frame++) {
+    frame_strings(frame, str_tmp, str_press, str_umi);
+    old_redraw(&old_ssd, true, str_tmp, str_press, str_umi);
+    bench_consume(old_ssd.ram_buffer[1 + frame % (WIDTH * 8)]);
+  }
+  double old_us = (double)(bench_now_ns() - start) / FRAMES / 1000.0;
+
+  start = bench_now_ns();
+  for (int frame = 0; frame < FRAMES; frame++) {
+    frame_strings(frame, str_tmp, str_press, str_umi);
+    new_redraw(&new_ssd, true, str_tmp, str_press, str_umi);
+    bench_consume(new_ssd.ram_buffer[1 + frame % (WIDTH * 8)]);
+  }
+  double new_us = (double)(bench_now_ns() - start) / FRAMES / 1000.0;
+
+  // Redesenho + montagem do envio (comparação com o painel e janelas alteradas)
+  uint64_t bytes = 0;
+  start = bench_now_ns();
+  for (int frame = 0; frame < FRAMES; frame++) {
+    frame_strings(frame, str_tmp, str_press, str_umi);
+    new_redraw(&new_ssd, true, str_tmp, str_press, str_umi);
+    BENCH_CHECK(ssd1306_begin_flush(&new_ssd), "envio %d recusado com o DMA livre", frame);
+    bytes += new_ssd.frame_bytes;
+  }
+  double flush_us = (double)(bench_now_ns() - start) / FRAMES / 1000.0;
+
+  ssd1306_invalidate(&new_ssd);
+  ssd1306_begin_flush(&new_ssd);
+  uint32_t full_bytes = new_ssd.frame_bytes;
+
+  printf("pixel a pixel: %.2f us/quadro\n", old_us);
+  printf("bytes de página: %.2f us/quadro (%.1fx)\n", new_us, old_us / new_us);
+  printf("redesenho + begin_flush: %.2f us/quadro, %.0f bytes I2C/quadro (quadro inteiro: %lu)\n",
+         flush_us, (double)bytes / FRAMES, (unsigned long)full_bytes);
+  return bench_failures != 0;
+}
@@ -0,0 +1,65 @@
+#ifndef BENCH_HARDWARE_DMA_H
+#define BENCH_HARDWARE_DMA_H
+
+// Substituto do hardware/dma.h para o host (tools/bench): a transferência termina na hora
+// (nada é copiado) e dispara a IRQ registrada, como no fim de um envio real
+
+#include "pico/stdlib.h"
+#include "hardware/irq.h"
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+typedef struct {
+    uint32_t ctrl;
+} dma_channel_config;
+
+static inline int dma_claim_unused_channel(bool required) {
+    (void)required;
+    return 0;
+}
+
+static inline dma_channel_config dma_channel_get_default_config(uint channel) {
+    (void)channel;
+    return (dma_channel_config){ 0 };
+}
+
+static inline void channel_config_set_transfer_data_size(dma_channel_config* c, enum dma_channel_transfer_size size) {
+    (void)c; (void)size;
+}
+
+static inline void channel_config_set_read_increment(dma_channel_config* c, bool incr) {
+    (void)c; (void)incr;
+}
+
+static inline void channel_config_set_write_increment(dma_channel_config* c, bool incr) {
+    (void)c; (void)incr;
+}
+
+static inline void channel_config_set_dreq(dma_channel_config* c, uint dreq) {
+    (void)c; (void)dreq;
+}
+
+static inline void dma_channel_configure(uint channel, const dma_channel_config* config, volatile void* write_addr,
+                                         const volatile void* read_addr, uint transfer_count, bool trigger) {
+    (void)channel; (void)config; (void)write_addr; (void)read_addr; (void)transfer_count; (void)trigger;
+}
+
+static inline void dma_channel_set_irq1_enabled(uint channel, bool enabled) {
+    (void)channel; (void)enabled;
+}
+
+static inline bool dma_channel_get_irq1_status(uint channel) {
+    (void)channel;
+    return true;
+}
+
+static inline void dma_channel_acknowledge_irq1(uint channel) {
+    (void)channel;
+}
+
+static inline void dma_channel_transfer_from_buffer_now(uint channel, const volatile void* read_addr, uint32_t count) {
+    (void)channel; (void)read_addr; (void)count;
+    if (bench_dma_irq_handler) bench_dma_irq_handler();
+}
+
+#endif // BENCH_HARDWARE_DMA_H
@@ -0,0 +1,22 @@
+#ifndef BENCH_HARDWARE_FLASH_H
+#define BENCH_HARDWARE_FLASH_H
+
+// Substituto do hardware/flash.h para o host (tools/bench). Só compila o código de
+// persistência: apagar/gravar não fazem nada e a região XIP não deve ser lida
+
+#include "pico/stdlib.h"
+
+#define XIP_BASE              ((uintptr_t)0x10000000u)
+#define PICO_FLASH_SIZE_BYTES (2u * 1024u * 1024u)
+#define FLASH_SECTOR_SIZE     4096u
+#define FLASH_PAGE_SIZE       256u
+
+static inline void flash_range_erase(uint32_t offset, size_t count) {
+    (void)offset; (void)count;
+}
+
+static inline void flash_range_program(uint32_t offset, const uint8_t* data, size_t count) {
+    (void)offset; (void)data; (void)count;
+}
+
+#endif // BENCH_HARDWARE_FLASH_H
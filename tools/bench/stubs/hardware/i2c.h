@@ -0,0 +1,51 @@
+#ifndef BENCH_HARDWARE_I2C_H
+#define BENCH_HARDWARE_I2C_H
+
+// Substituto do hardware/i2c.h para compilar os drivers no host (tools/bench).
+// Não há barramento: escritas são descartadas e leituras devolvem bench_i2c_rx
+// (zeros, a menos que o benchmark preencha o buffer com a resposta do sensor)
+
+#include <string.h>
+#include "pico/stdlib.h"
+
+#define _u(x) x##u
+
+typedef struct i2c_inst i2c_inst_t;
+
+// Registradores usados pelo envio por DMA do SSD1306: a FIFO está sempre vazia e parada
+typedef struct {
+    volatile uint32_t enable, tar, data_cmd, raw_intr_stat, clr_tx_abrt, status;
+} i2c_hw_t;
+
+#define I2C_IC_DATA_CMD_STOP_BITS           0x00000200u
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS   0x00000040u
+#define I2C_IC_STATUS_TFE_BITS              0x00000004u
+#define I2C_IC_STATUS_ACTIVITY_BITS         0x00000001u
+
+__attribute__((weak)) i2c_hw_t bench_i2c_hw = { .status = I2C_IC_STATUS_TFE_BITS };
+
+static inline i2c_hw_t* i2c_get_hw(i2c_inst_t* i2c) {
+    (void)i2c;
+    return &bench_i2c_hw;
+}
+
+static inline uint i2c_get_dreq(i2c_inst_t* i2c, bool is_tx) {
+    (void)i2c; (void)is_tx;
+    return 0;
+}
+
+// Resposta das leituras; fraca para poder aparecer em várias unidades de compilação
+__attribute__((weak)) uint8_t bench_i2c_rx[32];
+
+static inline int i2c_write_blocking(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop) {
+    (void)i2c; (void)addr; (void)src; (void)nostop;
+    return (int)len;
+}
+
+static inline int i2c_read_blocking(i2c_inst_t* i2c, uint8_t addr, uint8_t* dst, size_t len, bool nostop) {
+    (void)i2c; (void)addr; (void)nostop;
+    memcpy(dst, bench_i2c_rx, len);
+    return (int)len;
+}
+
+#endif // BENCH_HARDWARE_I2C_H
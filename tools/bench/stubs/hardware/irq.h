@@ -0,0 +1,25 @@
+#ifndef BENCH_HARDWARE_IRQ_H
+#define BENCH_HARDWARE_IRQ_H
+
+// Substituto do hardware/irq.h para o host (tools/bench): guarda o handler do DMA para
+// que o stub de hardware/dma.h o chame ao "terminar" uma transferência
+
+#include "pico/stdlib.h"
+
+#define DMA_IRQ_1 12
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+typedef void (*irq_handler_t)(void);
+
+__attribute__((weak)) irq_handler_t bench_dma_irq_handler;
+
+static inline void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    (void)num; (void)order_priority;
+    bench_dma_irq_handler = handler;
+}
+
+static inline void irq_set_enabled(uint num, bool enabled) {
+    (void)num; (void)enabled;
+}
+
+#endif // BENCH_HARDWARE_IRQ_H
@@ -0,0 +1,16 @@
+#ifndef BENCH_HARDWARE_SYNC_H
+#define BENCH_HARDWARE_SYNC_H
+
+// Substituto do hardware/sync.h para o host (tools/bench): sem interrupções a mascarar
+
+#include "pico/stdlib.h"
+
+static inline uint32_t save_and_disable_interrupts(void) {
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t status) {
+    (void)status;
+}
+
+#endif // BENCH_HARDWARE_SYNC_H
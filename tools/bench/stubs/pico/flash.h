@@ -0,0 +1,16 @@
+#ifndef BENCH_PICO_FLASH_H
+#define BENCH_PICO_FLASH_H
+
+// Substituto do pico/flash.h para o host (tools/bench): nada é gravado
+
+#include "pico/stdlib.h"
+
+#define PICO_OK 0
+
+static inline int flash_safe_execute(void (*func)(void*), void* param, uint32_t timeout_ms) {
+    (void)timeout_ms;
+    func(param);
+    return PICO_OK;
+}
+
+#endif // BENCH_PICO_FLASH_H
@@ -0,0 +1,40 @@
+#ifndef BENCH_PICO_STDLIB_H
+#define BENCH_PICO_STDLIB_H
+
+// Substituto mínimo do pico/stdlib.h para compilar as bibliotecas no host (tools/bench).
+// Só o que as fontes testadas usam: tipos, o relógio desde o boot, prazos e espera
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+static inline absolute_time_t get_absolute_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000u);
+}
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) {
+    return get_absolute_time() + (uint64_t)ms * 1000u;
+}
+
+static inline bool time_reached(absolute_time_t t) {
+    return get_absolute_time() >= t;
+}
+
+static inline void sleep_ms(uint32_t ms) {
+    struct timespec ts = { ms / 1000u, (long)(ms % 1000u) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+static inline void tight_loop_contents(void) {}
+
+#endif // BENCH_PICO_STDLIB_H
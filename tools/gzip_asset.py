@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""Gera um header C com um recurso estático comprimido com gzip.
+
+Uso: gzip_asset.py <header de entrada> <símbolo> <header de saída>
+
+Lê a string C `<símbolo>[] = "..." "..." ...;` do header de entrada (a fonte
+editável da página continua sendo o header), comprime o conteúdo com gzip -9
+sem nome nem data (saída reprodutível) e escreve <símbolo>_GZ e <símbolo>_GZ_LEN.
+Também escreve ETags fortes derivadas do SHA-256 do conteúdo: <símbolo>_ETAG
+(identidade) e <símbolo>_GZ_ETAG (gzip), que mudam a cada alteração da página.
+"""
+
+import gzip
+import hashlib
+import re
+import sys
+
+ESCAPES = {'n': b'\n', 't': b'\t', 'r': b'\r', '0': b'\0', '"': b'"', "'": b"'", '\\': b'\\', '?': b'?'}
+
+
+def decode_literal(body):
+    """Decodifica o conteúdo de um literal de string C (sem as aspas) em bytes."""
+    out = bytearray()
+    i = 0
+    while i < len(body):
+        c = body[i]
+        if c != '\\':
+            out += c.encode('utf-8')
+            i += 1
+            continue
+        nxt = body[i + 1]
+        if nxt == 'x':
+            m = re.match(r'[0-9a-fA-F]+', body[i + 2:])
+            out.append(int(m.group(0), 16) & 0xFF)
+            i += 2 + len(m.group(0))
+        elif nxt in '01234567':
+            m = re.match(r'[0-7]{1,3}', body[i + 1:])
+            out.append(int(m.group(0), 8) & 0xFF)
+            i += 1 + len(m.group(0))
+        else:
+            out += ESCAPES[nxt]
+            i += 2
+    return bytes(out)
+
+
+def extract_string(source, symbol):
+    start = re.search(r'\b' + re.escape(symbol) + r'\s*\[\s*\]\s*=', source)
+    if not start:
+        sys.exit(f'{symbol} não encontrado')
+    data = bytearray()
+    pos = start.end()
+    literal = re.compile(r'\s*"((?:[^"\\\n]|\\.)*)"')
+    while True:
+        m = literal.match(source, pos)
+        if not m:
+            break
+        data += decode_literal(m.group(1))
+        pos = m.end()
+    if not re.match(r'\s*;', source[pos:]):
+        sys.exit(f'{symbol}: inicializador não é uma sequência de literais')
+    return bytes(data)
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.exit(__doc__)
+    src_path, symbol, out_path = sys.argv[1:]
+    with open(src_path, encoding='utf-8') as f:
+        raw = extract_string(f.read(), symbol)
+    packed = gzip.compress(raw, compresslevel=9, mtime=0)
+    digest = hashlib.sha256(raw).hexdigest()[:16]
+
+    guard = re.sub(r'\W', '_', out_path.rsplit('/', 1)[-1]).upper()
+    lines = [
+        '// -------------------------------------------------- //',
+        '// Gerado por tools/gzip_asset.py; não edite!          //',
+        '// -------------------------------------------------- //',
+        '',
+        f'#ifndef {guard}',
+        f'#define {guard}',
+        '',
+        '#include <stdint.h>',
+        '',
+        f'// {symbol} ({len(raw)} bytes) comprimido com gzip: {len(packed)} bytes',
+        f'#define {symbol}_GZ_LEN {len(packed)}u',
+        '',
+        '// ETags fortes (uma por codificação)',
+        f'#define {symbol}_ETAG "\\"{digest}\\""',
+        f'#define {symbol}_GZ_ETAG "\\"{digest}-gz\\""',
+        '',
+        f'static const uint8_t {symbol}_GZ[{len(packed)}] = {{',
+    ]
+    for i in range(0, len(packed), 16):
+        lines.append('    ' + ', '.join(f'0x{b:02x}' for b in packed[i:i + 16]) + ',')
+    lines += ['};', '', f'#endif // {guard}', '']
+
+    with open(out_path, 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(lines))
+
+
+if __name__ == '__main__':
+    main()